@@ -25,6 +25,7 @@
 #include "common/PrecompiledHeader.h"
 #include "common/Threading.h"
 #include "common/Assertions.h"
+#include "common/PerfTrace.h"
 
 // Note: assuming multicore is safer because it forces the interlocked routines to use
 // the LOCK prefix.  The prefix works on single core CPUs fine (but is slow), but not
@@ -226,6 +227,7 @@ void Threading::Thread::Join()
 // name can be up to 16 bytes
 void Threading::SetNameOfCurrentThread(const char* name)
 {
+	PerfTrace::SetCurrentThreadName(name);
 	pthread_setname_np(name);
 }
 
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdio>
 #include <map>
 #include <memory>
 #include <string>
@@ -141,6 +142,14 @@ namespace HostSys
 	extern void DestroySharedMemory(void* ptr);
 	extern void* MapSharedMemory(void* handle, size_t offset, void* baseaddr, size_t size, const PageProtectionMode& mode);
 	extern void UnmapSharedMemory(void* baseaddr, size_t size);
+
+	// Maps an open file read/write, so stores go straight to the page cache, or read-only if writable
+	// is false. Returns NULL on failure. The mapping stays valid after the file is closed.
+	extern void* MapFile(std::FILE* fp, size_t size, bool writable = true);
+	extern void UnmapFile(void* baseaddr, size_t size);
+
+	// Starts writing back modified pages in the range, without waiting for them to reach the disk.
+	extern void FlushMappedFile(void* baseaddr, size_t size);
 }
 
 class SharedMemoryMappingArea
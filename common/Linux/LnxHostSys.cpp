@@ -226,6 +226,30 @@ void HostSys::UnmapSharedMemory(void* baseaddr, size_t size)
 		pxFailRel("Failed to unmap shared memory");
 }
 
+void* HostSys::MapFile(std::FILE* fp, size_t size, bool writable)
+{
+	void* ptr = mmap(nullptr, size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fileno(fp), 0);
+	if (ptr == MAP_FAILED)
+		return nullptr;
+
+	return ptr;
+}
+
+void HostSys::UnmapFile(void* baseaddr, size_t size)
+{
+	if (munmap(baseaddr, size) != 0)
+		pxFailRel("Failed to unmap file");
+}
+
+void HostSys::FlushMappedFile(void* baseaddr, size_t size)
+{
+	// msync() wants a page aligned address.
+	const uptr start = reinterpret_cast<uptr>(baseaddr) & ~static_cast<uptr>(__pagesize - 1);
+	const uptr end = reinterpret_cast<uptr>(baseaddr) + size;
+	if (msync(reinterpret_cast<void*>(start), end - start, MS_ASYNC) != 0)
+		Console.Error("msync() failed: %d", errno);
+}
+
 SharedMemoryMappingArea::SharedMemoryMappingArea(u8* base_ptr, size_t size, size_t num_pages)
 	: m_base_ptr(base_ptr)
 	, m_size(size)
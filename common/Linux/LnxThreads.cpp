@@ -39,6 +39,7 @@
 
 #include "common/Threading.h"
 #include "common/Assertions.h"
+#include "common/PerfTrace.h"
 
 // We wont need this until we actually have this more then just stubbed out, so I'm commenting this out
 // to remove an unneeded dependency.
@@ -358,6 +359,8 @@ Threading::ThreadHandle& Threading::Thread::operator=(Thread&& thread)
 
 void Threading::SetNameOfCurrentThread(const char* name)
 {
+	PerfTrace::SetCurrentThreadName(name);
+
 #if defined(__linux__)
 	// Extract of manpage: "The name can be up to 16 bytes long, and should be
 	//						null-terminated if it contains fewer bytes."
@@ -0,0 +1,244 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+
+#include "common/PerfTrace.h"
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/StringUtil.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace PerfTrace
+{
+	namespace
+	{
+		struct Event
+		{
+			const char* category;
+			const char* name;
+			Common::Timer::Value start;
+			Common::Timer::Value end;
+		};
+
+		// Only the owning thread writes a slot. seq holds the event index + 1 once the slot is
+		// complete, and zero while it's being rewritten, so a reader copying the slot at the same
+		// time can tell the copy is torn and drop it.
+		struct EventSlot
+		{
+			std::atomic<u64> seq{0};
+			std::atomic<const char*> category{nullptr};
+			std::atomic<const char*> name{nullptr};
+			std::atomic<Common::Timer::Value> start{0};
+			std::atomic<Common::Timer::Value> end{0};
+		};
+
+		// Must be a power of two. Each traced thread gets one, about 2.5MB worth.
+		static constexpr u64 BUFFER_SIZE = 65536;
+
+		// Only the owning thread writes events and advances head, so recording never takes a lock.
+		struct ThreadBuffer
+		{
+			std::atomic<u64> head{0};
+			std::atomic<u64> first{0};
+			u32 tid = 0;
+			bool exited = false;
+			std::string name;
+			EventSlot events[BUFFER_SIZE];
+		};
+
+		// Flags the thread's buffer when it exits. The buffer is kept until the next export or
+		// start, so events from threads which exit while tracing still make it into the trace.
+		struct ThreadBufferOwner
+		{
+			ThreadBuffer* buffer = nullptr;
+
+			~ThreadBufferOwner();
+		};
+	} // namespace
+
+	std::atomic_bool g_enabled{false};
+
+	static std::mutex s_mutex;
+	static std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+	static Common::Timer::Value s_start_time = 0;
+	static u32 s_next_tid = 0;
+
+	static thread_local ThreadBufferOwner s_thread_buffer;
+	static thread_local char s_thread_name[32] = {};
+
+	static ThreadBuffer* CreateThreadBuffer();
+	static void FreeExitedBuffers();
+	static void WriteEscaped(std::FILE* fp, const char* str);
+} // namespace PerfTrace
+
+PerfTrace::ThreadBufferOwner::~ThreadBufferOwner()
+{
+	if (!buffer)
+		return;
+
+	std::unique_lock lock(s_mutex);
+	buffer->exited = true;
+}
+
+PerfTrace::ThreadBuffer* PerfTrace::CreateThreadBuffer()
+{
+	std::unique_ptr<ThreadBuffer> buf = std::make_unique<ThreadBuffer>();
+	std::unique_lock lock(s_mutex);
+	buf->tid = ++s_next_tid;
+	buf->name = s_thread_name[0] ? s_thread_name : fmt::format("Thread {}", buf->tid);
+	s_thread_buffer.buffer = buf.get();
+	s_buffers.push_back(std::move(buf));
+	return s_thread_buffer.buffer;
+}
+
+void PerfTrace::FreeExitedBuffers()
+{
+	s_buffers.erase(std::remove_if(s_buffers.begin(), s_buffers.end(),
+						[](const std::unique_ptr<ThreadBuffer>& buf) { return buf->exited; }),
+		s_buffers.end());
+}
+
+void PerfTrace::Start()
+{
+	std::unique_lock lock(s_mutex);
+	FreeExitedBuffers();
+	for (const std::unique_ptr<ThreadBuffer>& buf : s_buffers)
+		buf->first.store(buf->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+
+	s_start_time = Common::Timer::GetCurrentValue();
+	g_enabled.store(true, std::memory_order_release);
+	Console.WriteLn("Performance trace started.");
+}
+
+void PerfTrace::Stop()
+{
+	g_enabled.store(false, std::memory_order_release);
+	Console.WriteLn("Performance trace stopped.");
+}
+
+void PerfTrace::SetCurrentThreadName(const char* name)
+{
+	StringUtil::Strlcpy(s_thread_name, name, sizeof(s_thread_name));
+	if (s_thread_buffer.buffer)
+	{
+		std::unique_lock lock(s_mutex);
+		s_thread_buffer.buffer->name = s_thread_name;
+	}
+}
+
+void PerfTrace::Record(const char* category, const char* name, Common::Timer::Value start, Common::Timer::Value end)
+{
+	ThreadBuffer* buf = s_thread_buffer.buffer;
+	if (!buf)
+		buf = CreateThreadBuffer();
+
+	const u64 pos = buf->head.load(std::memory_order_relaxed);
+	EventSlot& slot = buf->events[pos & (BUFFER_SIZE - 1)];
+	slot.seq.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.category.store(category, std::memory_order_relaxed);
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.start.store(start, std::memory_order_relaxed);
+	slot.end.store(end, std::memory_order_relaxed);
+	slot.seq.store(pos + 1, std::memory_order_release);
+	buf->head.store(pos + 1, std::memory_order_release);
+}
+
+void PerfTrace::WriteEscaped(std::FILE* fp, const char* str)
+{
+	for (; *str; str++)
+	{
+		if (*str == '"' || *str == '\\')
+			std::fputc('\\', fp);
+		if (static_cast<unsigned char>(*str) >= 0x20)
+			std::fputc(*str, fp);
+	}
+}
+
+bool PerfTrace::Export(const char* filename)
+{
+	auto fp = FileSystem::OpenManagedCFile(filename, "wb");
+	if (!fp)
+	{
+		Console.Error("Failed to open '%s' for writing performance trace.", filename);
+		return false;
+	}
+
+	std::unique_lock lock(s_mutex);
+	std::vector<Event> events;
+	u64 num_events = 0;
+
+	std::fputs("{\"traceEvents\":[\n", fp.get());
+	bool first_line = true;
+	for (const std::unique_ptr<ThreadBuffer>& buf : s_buffers)
+	{
+		std::fprintf(fp.get(), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+			first_line ? "" : ",\n", buf->tid);
+		WriteEscaped(fp.get(), buf->name.c_str());
+		std::fputs("\"}}", fp.get());
+		first_line = false;
+
+		const u64 head = buf->head.load(std::memory_order_acquire);
+		const u64 start = std::max(buf->first.load(std::memory_order_relaxed), (head > BUFFER_SIZE) ? (head - BUFFER_SIZE) : 0);
+		events.clear();
+		for (u64 pos = start; pos < head; pos++)
+		{
+			// Skip slots the thread has wrapped around onto since we read head.
+			const EventSlot& slot = buf->events[pos & (BUFFER_SIZE - 1)];
+			if (slot.seq.load(std::memory_order_acquire) != pos + 1)
+				continue;
+
+			const Event ev = {slot.category.load(std::memory_order_relaxed), slot.name.load(std::memory_order_relaxed),
+				slot.start.load(std::memory_order_relaxed), slot.end.load(std::memory_order_relaxed)};
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.seq.load(std::memory_order_relaxed) == pos + 1)
+				events.push_back(ev);
+		}
+
+		for (const Event& ev : events)
+		{
+			if (ev.start < s_start_time || ev.end < ev.start)
+				continue;
+
+			std::fprintf(fp.get(), ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				ev.name, ev.category, buf->tid,
+				Common::Timer::ConvertValueToNanoseconds(ev.start - s_start_time) / 1000.0,
+				Common::Timer::ConvertValueToNanoseconds(ev.end - ev.start) / 1000.0);
+			num_events++;
+		}
+	}
+	std::fputs("\n]}\n", fp.get());
+
+	// Threads which have exited are in this trace now, nothing else will need their buffers.
+	const size_t num_threads = s_buffers.size();
+	FreeExitedBuffers();
+
+	if (std::ferror(fp.get()))
+	{
+		Console.Error("Failed to write performance trace to '%s'.", filename);
+		return false;
+	}
+
+	Console.WriteLn("Wrote %llu trace events from %zu threads to '%s'.", static_cast<unsigned long long>(num_events), num_threads, filename);
+	return true;
+}
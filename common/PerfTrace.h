@@ -0,0 +1,77 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+#include "common/Timer.h"
+
+#include <atomic>
+
+// Scoped timing zones for the hot subsystems, recorded into per-thread ring buffers and
+// exported as Chrome trace event JSON (loadable in chrome://tracing or ui.perfetto.dev).
+//
+// Zone names and categories must be string literals, only the pointers are recorded.
+// While tracing is off, a zone costs a single relaxed load and branch.
+namespace PerfTrace
+{
+	extern std::atomic_bool g_enabled;
+
+	static __fi bool IsEnabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+	/// Starts recording, discarding anything recorded previously.
+	void Start();
+
+	/// Stops recording. Events recorded so far are kept until the next Start().
+	void Stop();
+
+	/// Writes everything recorded to a Chrome trace event JSON file.
+	bool Export(const char* filename);
+
+	/// Names the calling thread in exported traces.
+	void SetCurrentThreadName(const char* name);
+
+	/// Records a completed zone on the calling thread.
+	void Record(const char* category, const char* name, Common::Timer::Value start, Common::Timer::Value end);
+
+	class ScopedZone
+	{
+	public:
+		__fi ScopedZone(const char* category, const char* name)
+			: m_category(category)
+			, m_name(name)
+			, m_start(IsEnabled() ? Common::Timer::GetCurrentValue() : 0)
+		{
+		}
+
+		__fi ~ScopedZone()
+		{
+			if (m_start != 0)
+				Record(m_category, m_name, m_start, Common::Timer::GetCurrentValue());
+		}
+
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+
+	private:
+		const char* m_category;
+		const char* m_name;
+		Common::Timer::Value m_start;
+	};
+} // namespace PerfTrace
+
+#define PERF_TRACE_CONCAT_(a, b) a##b
+#define PERF_TRACE_CONCAT(a, b) PERF_TRACE_CONCAT_(a, b)
+#define PERF_TRACE_ZONE(category, name) PerfTrace::ScopedZone PERF_TRACE_CONCAT(perf_trace_zone_, __LINE__)(category, name)
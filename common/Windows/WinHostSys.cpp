@@ -26,6 +26,8 @@
 
 #include "fmt/format.h"
 
+#include <io.h>
+
 static long DoSysPageFaultExceptionFilter(EXCEPTION_POINTERS* eps)
 {
 	if (eps->ExceptionRecord->ExceptionCode != EXCEPTION_ACCESS_VIOLATION)
@@ -156,6 +158,35 @@ void HostSys::UnmapSharedMemory(void* baseaddr, size_t size)
 		pxFail("Failed to unmap shared memory");
 }
 
+void* HostSys::MapFile(std::FILE* fp, size_t size, bool writable)
+{
+	const HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(fp)));
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	const HANDLE mapping = CreateFileMappingW(file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+	if (!mapping)
+		return nullptr;
+
+	// The view keeps the mapping object alive.
+	void* ret = MapViewOfFile(mapping, writable ? (FILE_MAP_READ | FILE_MAP_WRITE) : FILE_MAP_READ, 0, 0, size);
+	CloseHandle(mapping);
+	return ret;
+}
+
+void HostSys::UnmapFile(void* baseaddr, size_t size)
+{
+	if (!UnmapViewOfFile(baseaddr))
+		pxFail("Failed to unmap file");
+}
+
+void HostSys::FlushMappedFile(void* baseaddr, size_t size)
+{
+	// Queues the dirty pages for writing, but doesn't wait on the disk (no FlushFileBuffers()).
+	if (!FlushViewOfFile(baseaddr, size))
+		Console.Error("FlushViewOfFile() failed: %u", GetLastError());
+}
+
 SharedMemoryMappingArea::SharedMemoryMappingArea(u8* base_ptr, size_t size, size_t num_pages)
 	: m_base_ptr(base_ptr)
 	, m_size(size)
@@ -17,6 +17,7 @@
 
 #include "common/Threading.h"
 #include "common/Assertions.h"
+#include "common/PerfTrace.h"
 #include "common/emitter/tools.h"
 #include "common/RedtapeWindows.h"
 #include <mmsystem.h>
@@ -223,6 +224,8 @@ u64 Threading::GetThreadTicksPerSecond()
 
 void Threading::SetNameOfCurrentThread(const char* name)
 {
+	PerfTrace::SetCurrentThreadName(name);
+
 	// This feature needs Windows headers and MSVC's SEH support:
 
 #if defined(_WIN32) && defined(_MSC_VER)
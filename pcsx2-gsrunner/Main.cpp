@@ -44,6 +44,7 @@
 #include "pcsx2/Frontend/LogSink.h"
 #include "pcsx2/GS.h"
 #include "pcsx2/GS/GS.h"
+#include "pcsx2/GS/Renderers/Null/GSDeviceNull.h"
 #include "pcsx2/GSDumpReplayer.h"
 #include "pcsx2/HostDisplay.h"
 #include "pcsx2/HostSettings.h"
@@ -76,6 +77,7 @@ alignas(16) static SysMtgsThread s_mtgs_thread;
 static std::string s_output_prefix;
 static s32 s_loop_count = 1;
 static std::optional<bool> s_use_window;
+static bool s_use_null_device = false;
 
 // Owned by the GS thread.
 static u32 s_dump_frame_number = 0;
@@ -248,7 +250,7 @@ bool Host::AcquireHostDisplay(RenderAPI api, bool clear_state_on_fail)
 	if (!wi.has_value())
 		return false;
 
-	g_host_display = HostDisplay::CreateForAPI(api);
+	g_host_display = HostDisplay::CreateForAPI(s_use_null_device ? RenderAPI::None : api);
 	if (!g_host_display)
 		return false;
 
@@ -435,6 +437,7 @@ static void PrintCommandLineHelp(const char* progname)
 	std::fprintf(stderr, "  -renderer <renderer>: Sets the graphics renderer. Defaults to Auto.\n");
 	std::fprintf(stderr, "  -window: Forces a window to be displayed.\n");
 	std::fprintf(stderr, "  -surfaceless: Disables showing a window.\n");
+	std::fprintf(stderr, "  -nulldevice: Runs the renderer without a GPU, and reports GS thread CPU time per draw.\n");
 	std::fprintf(stderr, "  -logfile <filename>: Writes emu log to filename.\n");
 	std::fprintf(stderr, "  -noshadercache: Disables the shader cache (useful for parallel runs).\n");
 	std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
@@ -555,6 +558,12 @@ static bool ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& param
 				s_use_window = false;
 				continue;
 			}
+			else if (CHECK_ARG("-nulldevice"))
+			{
+				Console.WriteLn("Using null GS device");
+				s_use_null_device = true;
+				continue;
+			}
 			else if (CHECK_ARG("--"))
 			{
 				no_more_args = true;
@@ -602,6 +611,19 @@ static bool ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& param
 	return true;
 }
 
+static void PrintNullDeviceStatistics()
+{
+	// Nothing is executed on a GPU, so the GS thread's CPU time is the whole cost of the renderer.
+	u64 draws = 0;
+	GetMTGS().RunOnGSThread([&draws]() { draws = static_cast<GSDeviceNull*>(g_gs_device.get())->GetDrawCount(); });
+	GetMTGS().WaitGS(false);
+
+	const double gs_time = static_cast<double>(GetMTGS().GetThreadHandle().GetCPUTime()) /
+						   static_cast<double>(Threading::GetThreadTicksPerSecond());
+	Console.WriteLn(Color_StrongGreen, "GS thread CPU time: %.3f seconds for %llu draws (%.3f us/draw)", gs_time,
+		static_cast<unsigned long long>(draws), (draws > 0) ? (gs_time * 1000000.0 / static_cast<double>(draws)) : 0.0);
+}
+
 int main(int argc, char* argv[])
 {
 	CommonHost::InitializeEarlyConsole();
@@ -639,6 +661,8 @@ int main(int argc, char* argv[])
 		VMManager::SetState(VMState::Running);
 		while (VMManager::GetState() == VMState::Running)
 			VMManager::Execute();
+		if (s_use_null_device)
+			PrintNullDeviceStatistics();
 		VMManager::Shutdown(false);
 	}
 
@@ -16,6 +16,7 @@
 #include "PrecompiledHeader.h"
 #include "ThreadedFileReader.h"
 
+#include "common/PerfTrace.h"
 #include "common/Threading.h"
 
 // Make sure buffer size is bigger than the cutoff where PCSX2 emulates a seek
@@ -188,6 +189,8 @@ ThreadedFileReader::Buffer* ThreadedFileReader::GetBlockPtr(const Chunk& block)
 
 bool ThreadedFileReader::Decompress(void* target, u64 begin, u32 size)
 {
+	PERF_TRACE_ZONE("CDVD", "Read");
+
 	char* write = static_cast<char*>(target);
 	u32 remaining = size;
 	u64 off = begin;
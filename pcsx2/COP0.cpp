@@ -244,6 +244,9 @@ void MapTLB(const tlbs& t, int i)
 		i, t.VPN2, t.PFN0, t.PFN1, t.S >> 31, t.G, t.ASID,
 		t.Mask, t.EntryLo0 >> 6, (t.EntryLo0 & 0x38) >> 3, t.EntryLo1 >> 6, (t.EntryLo1 & 0x38) >> 3, t.VPN2);
 
+	// Done first, so the pages mapped below pick up the entry's cache attribute.
+	vtlb_UpdateCacheablePages();
+
 	if (t.S)
 	{
 		vtlb_VMapBuffer(t.VPN2, eeMem->Scratch, Ps2MemSize::Scratch);
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <thread>
 #include <atomic>
 #include <mutex>
@@ -45,6 +46,8 @@ private:
 	std::unique_ptr<u8[]> hddSparseBlock;
 	bool hddSparseBlockValid = false;
 
+	// Owned by hddImage, used for positional reads/writes.
+	// Data is never read or written through the FILE* itself.
 #ifdef _WIN32
 	HANDLE hddNativeHandle = INVALID_HANDLE_VALUE;
 #elif defined(__POSIX__)
@@ -123,6 +126,9 @@ private:
 		u64 sector;
 	};
 	SimpleQueue<WriteQueueEntry> writeQueue;
+	//Sequential writes are merged into a single write, up to this size
+	static constexpr u32 maxCoalescedWrite = 4 * 1024 * 1024;
+	std::vector<u8> coalesceBuffer;
 
 	std::thread ioThread;
 	bool ioRunning = false;
@@ -135,9 +141,23 @@ private:
 	std::atomic_bool ioClose{false};
 	bool ioWrite;
 	bool ioRead;
+	bool ioPrefetch;
 	void (ATA::*waitingCmd)() = nullptr;
 	//Write Buffer(s)
 
+	//Read-ahead Buffer
+	//Filled by ioThread with the sectors following the last read,
+	//only accessed by the EE thread while ioThread is idle
+	static constexpr int maxPrefetchSectors = 256;
+	std::unique_ptr<u8[]> prefetchBuffer;
+	u64 prefetchLBA = 0;
+	int prefetchSectors = 0;
+	bool prefetchValid = false;
+	//Incremented when a write is queued, invalidates any prefetch started before it
+	std::atomic<u32> writeGeneration{0};
+	u32 prefetchGeneration = 0;
+	//Read-ahead Buffer
+
 	//Read Buffer
 	int rdTransferred = 0;
 	int wrTransferred = 0;
@@ -219,6 +239,10 @@ private:
 	void IO_Thread();
 	void IO_Read();
 	bool IO_Write();
+	void IO_Prefetch();
+	bool IO_ReadAt(u64 byteOffset, void* data, u64 byteSize);
+	bool IO_WriteAt(u64 byteOffset, const void* data, u64 byteSize);
+	void HDD_QueuePrefetch(s64 lba, int sectors);
 	bool IO_SparseZero(u64 byteOffset, u64 byteSize);
 	void IO_SparseCacheUpdateLocation(u64 Offset);
 	void IO_SparseCacheLoad();
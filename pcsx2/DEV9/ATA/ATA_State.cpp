@@ -71,12 +71,31 @@ int ATA::Open(const std::string& hddPath)
 	//Store HddImage size for later check
 	hddImageSize = static_cast<u64>(size);
 
+	// Get OS specific file handle for positional reads/writes.
+	// Handle is owned by FILE* hddImage.
+#ifdef _WIN32
+	hddNativeHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(hddImage)));
+#elif defined(__POSIX__)
+	hddNativeHandle = fileno(hddImage);
+#endif
+	if (hddNativeHandle == INVALID_HANDLE_VALUE)
+	{
+		Console.Error("Failed to get native handle for HDD image '%s'", hddPath.c_str());
+		std::fclose(hddImage);
+		hddImage = nullptr;
+		return -1;
+	}
+
 	InitSparseSupport(hddPath);
 
+	prefetchBuffer = std::make_unique<u8[]>(maxPrefetchSectors * 512);
+	prefetchValid = false;
+
 	{
 		std::lock_guard ioSignallock(ioMutex);
 		ioRead = false;
 		ioWrite = false;
+		ioPrefetch = false;
 	}
 
 	ioThread = std::thread(&ATA::IO_Thread, this);
@@ -97,16 +116,6 @@ void ATA::InitSparseSupport(const std::string& hddPath)
 	if (!hddSparse)
 		return;
 
-	// Get OS specific file handle for spare writing.
-	// HANDLE is owned by FILE* hddImage.
-	hddNativeHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(hddImage)));
-	if (hddNativeHandle == INVALID_HANDLE_VALUE)
-	{
-		Console.Error("DEV9: ATA: Failed to open file for sparse");
-		hddSparse = false;
-		return;
-	}
-
 	// Get sparse block size (Initially assumed as 4096 bytes).
 	hddSparseBlockSize = 4096;
 
@@ -194,25 +203,17 @@ void ATA::InitSparseSupport(const std::string& hddPath)
 	// Otherwise assume SparseBlockSize == block size.
 
 #elif defined(__POSIX__)
-	// fd is owned by FILE* hddImage.
-	hddNativeHandle = fileno(hddImage);
-	hddSparse = false;
-	if (hddNativeHandle != -1)
-	{
-		// No way to check if we can hole punch without trying it
-		// so just assume sparse files are supported.
-		hddSparse = true;
-
-		// Get sparse block size (Initially assumed as 4096 bytes).
-		hddSparseBlockSize = 4096;
-		struct stat fileInfo;
-		if (fstat(hddNativeHandle, &fileInfo) == 0)
-			hddSparseBlockSize = fileInfo.st_blksize;
-		else
-			Console.Error("DEV9: ATA: Failed to get sparse block size (fstat returned != 0)");
-	}
+	// No way to check if we can hole punch without trying it
+	// so just assume sparse files are supported.
+	hddSparse = true;
+
+	// Get sparse block size (Initially assumed as 4096 bytes).
+	hddSparseBlockSize = 4096;
+	struct stat fileInfo;
+	if (fstat(hddNativeHandle, &fileInfo) == 0)
+		hddSparseBlockSize = fileInfo.st_blksize;
 	else
-		Console.Error("DEV9: ATA: Failed to open file for sparse");
+		Console.Error("DEV9: ATA: Failed to get sparse block size (fstat returned != 0)");
 #endif
 	hddSparseBlock = std::make_unique<u8[]>(hddSparseBlockSize);
 	hddSparseBlockValid = false;
@@ -243,16 +244,19 @@ void ATA::Close()
 	}
 
 	//Close File Handle
+	// hddNativeHandle is owned by hddImage.
+	// It will get closed in fclose(hddImage).
+	hddNativeHandle = INVALID_HANDLE_VALUE;
 	if (hddSparse)
 	{
-		// hddNativeHandle is owned by hddImage.
-		// It will get closed in fclose(hddImage).
-		hddNativeHandle = INVALID_HANDLE_VALUE;
-
 		hddSparse = false;
 		hddSparseBlock = nullptr;
 		hddSparseBlockValid = false;
 	}
+
+	prefetchBuffer = nullptr;
+	prefetchValid = false;
+	coalesceBuffer = {};
 	if (hddImage)
 	{
 		std::fclose(hddImage);
@@ -39,7 +39,7 @@ void ATA::IO_Thread()
 		ioThreadIdle_bool = true;
 		ioThreadIdle_cv.notify_all();
 
-		ioReady.wait(ioWaitHandle, [&] { return ioRead | ioWrite; });
+		ioReady.wait(ioWaitHandle, [&] { return ioRead | ioWrite | ioPrefetch; });
 		ioThreadIdle_bool = false;
 
 		int ioType = -1;
@@ -47,6 +47,8 @@ void ATA::IO_Thread()
 			ioType = 0;
 		else if (ioWrite)
 			ioType = 1;
+		else if (ioPrefetch)
+			ioType = 2;
 
 		ioWaitHandle.unlock();
 
@@ -67,9 +69,63 @@ void ATA::IO_Thread()
 				}
 			}
 		}
+		else if (ioType == 2)
+			IO_Prefetch();
 	}
 }
 
+bool ATA::IO_ReadAt(u64 byteOffset, void* data, u64 byteSize)
+{
+	u8* ptr = static_cast<u8*>(data);
+	while (byteSize > 0)
+	{
+#ifdef _WIN32
+		OVERLAPPED ov = {};
+		ov.Offset = static_cast<DWORD>(byteOffset);
+		ov.OffsetHigh = static_cast<DWORD>(byteOffset >> 32);
+		DWORD read;
+		if (!ReadFile(hddNativeHandle, ptr, static_cast<DWORD>(std::min<u64>(byteSize, 0x40000000)), &read, &ov) || read == 0)
+			return false;
+#elif defined(__POSIX__)
+		const ssize_t read = pread(hddNativeHandle, ptr, byteSize, byteOffset);
+		if (read < 0 && errno == EINTR)
+			continue;
+		if (read <= 0)
+			return false;
+#endif
+		ptr += read;
+		byteOffset += read;
+		byteSize -= read;
+	}
+	return true;
+}
+
+bool ATA::IO_WriteAt(u64 byteOffset, const void* data, u64 byteSize)
+{
+	const u8* ptr = static_cast<const u8*>(data);
+	while (byteSize > 0)
+	{
+#ifdef _WIN32
+		OVERLAPPED ov = {};
+		ov.Offset = static_cast<DWORD>(byteOffset);
+		ov.OffsetHigh = static_cast<DWORD>(byteOffset >> 32);
+		DWORD written;
+		if (!WriteFile(hddNativeHandle, ptr, static_cast<DWORD>(std::min<u64>(byteSize, 0x40000000)), &written, &ov) || written == 0)
+			return false;
+#elif defined(__POSIX__)
+		const ssize_t written = pwrite(hddNativeHandle, ptr, byteSize, byteOffset);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			return false;
+#endif
+		ptr += written;
+		byteOffset += written;
+		byteSize -= written;
+	}
+	return true;
+}
+
 void ATA::IO_Read()
 {
 	const s64 lba = HDD_GetLBA();
@@ -81,9 +137,15 @@ void ATA::IO_Read()
 		abort();
 	}
 
-	const u64 pos = lba * 512;
-	if (FileSystem::FSeek64(hddImage, pos, SEEK_SET) != 0 ||
-		std::fread(readBuffer,  512, nsector, hddImage) != static_cast<size_t>(nsector))
+	//Serve from read-ahead if possible
+	//Any write queued since the prefetch was started invalidates it
+	if (prefetchValid && prefetchGeneration == writeGeneration.load() &&
+		static_cast<u64>(lba) >= prefetchLBA &&
+		static_cast<u64>(lba) + nsector <= prefetchLBA + prefetchSectors)
+	{
+		memcpy(readBuffer, &prefetchBuffer[(lba - prefetchLBA) * 512], nsector * 512);
+	}
+	else if (!IO_ReadAt(lba * 512, readBuffer, static_cast<u64>(nsector) * 512))
 	{
 		Console.Error("DEV9: ATA: File read error");
 		pxAssert(false);
@@ -95,6 +157,16 @@ void ATA::IO_Read()
 	}
 }
 
+void ATA::IO_Prefetch()
+{
+	//Reads past the end of the image were excluded by HDD_QueuePrefetch
+	prefetchValid = IO_ReadAt(prefetchLBA * 512, prefetchBuffer.get(), static_cast<u64>(prefetchSectors) * 512);
+	{
+		std::lock_guard ioSignallock(ioMutex);
+		ioPrefetch = false;
+	}
+}
+
 bool ATA::IO_Write()
 {
 	WriteQueueEntry entry;
@@ -105,47 +177,60 @@ bool ATA::IO_Write()
 		return false;
 	}
 
-	u64 imagePos = entry.sector * 512;
-	if (FileSystem::FSeek64(hddImage, imagePos, SEEK_SET) != 0)
+	const u64 imagePos = entry.sector * 512;
+	u8* data = entry.data;
+	u32 length = entry.length;
+
+	//Merge following sequential writes (i.e. a multi command DMA stream)
+	WriteQueueEntry next;
+	if (writeQueue.Peek(&next) && next.sector * 512 == imagePos + length && length + next.length <= maxCoalescedWrite)
 	{
-		Console.Error("DEV9: ATA: File seek error");
-		pxAssert(false);
-		abort();
+		coalesceBuffer.assign(entry.data, entry.data + entry.length);
+		delete[] entry.data;
+
+		while (writeQueue.Peek(&next) && next.sector * 512 == imagePos + coalesceBuffer.size() &&
+			   coalesceBuffer.size() + next.length <= maxCoalescedWrite)
+		{
+			writeQueue.Dequeue(&next);
+			coalesceBuffer.insert(coalesceBuffer.end(), next.data, next.data + next.length);
+			delete[] next.data;
+		}
+
+		data = coalesceBuffer.data();
+		length = static_cast<u32>(coalesceBuffer.size());
 	}
+
 	if (hddSparse)
 	{
 		u32 written = 0;
-		while (written != entry.length)
+		while (written != length)
 		{
 			IO_SparseCacheUpdateLocation(imagePos + written);
 			// Align to sparse block size.
 			u32 writeSize = hddSparseBlockSize - ((imagePos + written) % hddSparseBlockSize);
 			// Limit to size of write.
-			writeSize = std::min(writeSize, entry.length - written);
+			writeSize = std::min(writeSize, length - written);
 
 			pxAssert(writeSize > 0);
 			pxAssert(writeSize <= hddSparseBlockSize);
 			pxAssert((imagePos + written) >= HddSparseStart);
 			pxAssert((imagePos + written) - HddSparseStart + writeSize <= hddSparseBlockSize);
 
-			bool sparseWrite = IsAllZero(&entry.data[written], writeSize);
+			bool sparseWrite = IsAllZero(&data[written], writeSize);
 
 			if (sparseWrite)
 			{
 #if defined(PCSX2_DEBUG) || defined(PCSX2_DEVBUILD)
 				std::unique_ptr<u8[]> zeroBlock = std::make_unique<u8[]>(writeSize);
 				memset(zeroBlock.get(), 0, writeSize);
-				pxAssert(memcmp(&entry.data[written], zeroBlock.get(), writeSize) == 0);
+				pxAssert(memcmp(&data[written], zeroBlock.get(), writeSize) == 0);
 #endif
 
 				if (!IO_SparseZero(imagePos + written, writeSize))
 				{
 					Console.Error("DEV9: ATA: File sparse write error");
 
-					// hddNativeHandle is owned by hddImage.
-					// do not close it.
-					hddNativeHandle = INVALID_HANDLE_VALUE;
-
+					// hddNativeHandle is still needed for normal writes.
 					hddSparse = false;
 					hddSparseBlock = nullptr;
 					hddSparseBlockValid = false;
@@ -163,15 +248,14 @@ bool ATA::IO_Write()
 				{
 					std::unique_ptr<u8[]> zeroBlock = std::make_unique<u8[]>(writeSize);
 					memset(zeroBlock.get(), 0, writeSize);
-					pxAssert(memcmp(&entry.data[written], zeroBlock.get(), writeSize) != 0);
+					pxAssert(memcmp(&data[written], zeroBlock.get(), writeSize) != 0);
 				}
 #endif
 				// Update cache.
 				if (hddSparseBlockValid)
-					memcpy(&hddSparseBlock[(imagePos + written) - HddSparseStart], &entry.data[written], writeSize);
+					memcpy(&hddSparseBlock[(imagePos + written) - HddSparseStart], &data[written], writeSize);
 
-				if (std::fwrite(&entry.data[written], writeSize, 1, hddImage) != 1 ||
-					std::fflush(hddImage) != 0)
+				if (!IO_WriteAt(imagePos + written, &data[written], writeSize))
 				{
 					Console.Error("DEV9: ATA: File write error");
 					pxAssert(false);
@@ -179,19 +263,19 @@ bool ATA::IO_Write()
 				}
 			}
 			written += writeSize;
-			pxAssert(FileSystem::FTell64(hddImage) == (s64)(imagePos + written));
 		}
 	}
 	else
 	{
-		if (std::fwrite(entry.data, entry.length, 1, hddImage) != 1 || std::fflush(hddImage) != 0)
+		if (!IO_WriteAt(imagePos, data, length))
 		{
 			Console.Error("DEV9: ATA: File write error");
 			pxAssert(false);
 			abort();
 		}
 	}
-	delete[] entry.data;
+	if (data == entry.data)
+		delete[] entry.data;
 	return true;
 }
 
@@ -209,12 +293,6 @@ void ATA::IO_SparseCacheLoad()
 		memset(&hddSparseBlock[readSize], 0, hddSparseBlockSize - readSize);
 	}
 
-	// Store file pointer.
-	const s64 orgPos = FileSystem::FTell64(hddImage);
-
-	// Flush so that we know what is allocated.
-	std::fflush(hddImage);
-
 #ifdef _WIN32
 	// FlushFileBuffers is required, hddSparseBlock differs from actual file without it.
 	FlushFileBuffers(hddNativeHandle);
@@ -235,22 +313,11 @@ void ATA::IO_SparseCacheLoad()
 		hddSparseBlockValid = true;
 #if defined(PCSX2_DEBUG) || defined(PCSX2_DEVBUILD)
 
-		// Store file pointer.
-		const s64 orgPos = FileSystem::FTell64(hddImage);
-		pxAssert(orgPos != -1);
-
 		//Load into check buffer.
-		FileSystem::FSeek64(hddImage, HddSparseStart, SEEK_SET);
-
 		std::unique_ptr<u8[]> temp = std::make_unique<u8[]>(hddSparseBlockSize);
 		memset(temp.get(), 0, hddSparseBlockSize);
 
-		if (FileSystem::FSeek64(hddImage, HddSparseStart, SEEK_SET) != 0 ||
-			std::fread((char*)hddSparseBlock.get(), readSize, 1, hddImage) != 1)
-			pxAssert(false);
-
-		// Restore file pointer.
-		if (FileSystem::FSeek64(hddImage, orgPos, SEEK_SET) != 0)
+		if (!IO_ReadAt(HddSparseStart, hddSparseBlock.get(), readSize))
 			pxAssert(false);
 
 		// Check if file is actully zeros.
@@ -282,22 +349,11 @@ void ATA::IO_SparseCacheLoad()
 			hddSparseBlockValid = true;
 #if defined(PCSX2_DEBUG) || defined(PCSX2_DEVBUILD)
 
-			// Store file pointer.
-			const s64 orgPos = FileSystem::FTell64(hddImage);
-			pxAssert(orgPos != -1);
-
 			// Load into check buffer.
-			FileSystem::FSeek64(hddImage, HddSparseStart, SEEK_SET);
-
 			std::unique_ptr<u8[]> temp = std::make_unique<u8[]>(hddSparseBlockSize);
 			memset(temp.get(), 0, hddSparseBlockSize);
 
-			if (FileSystem::FSeek64(hddImage, HddSparseStart, SEEK_SET) != 0 ||
-				std::fread((char*)hddSparseBlock.get(), readSize, 1, hddImage) != 1)
-				pxAssert(false);
-
-			// Restore file pointer.
-			if (FileSystem::FSeek64(hddImage, orgPos, SEEK_SET) != 0)
+			if (!IO_ReadAt(HddSparseStart, hddSparseBlock.get(), readSize))
 				pxAssert(false);
 
 			// Check if file is actully zeros.
@@ -319,10 +375,7 @@ void ATA::IO_SparseCacheLoad()
 #endif
 
 	// Load into cache.
-	if (orgPos == -1 ||
-		FileSystem::FSeek64(hddImage, HddSparseStart, SEEK_SET) != 0 ||
-		std::fread((char*)hddSparseBlock.get(), readSize, 1, hddImage) != 1 ||
-		FileSystem::FSeek64(hddImage, orgPos, SEEK_SET) != 0) // Restore file pointer.
+	if (!IO_ReadAt(HddSparseStart, hddSparseBlock.get(), readSize))
 	{
 		Console.Error("DEV9: ATA: File read error");
 		pxAssert(false);
@@ -343,7 +396,6 @@ void ATA::IO_SparseCacheUpdateLocation(u64 byteOffset)
 	}
 }
 
-// Also sets hddImage write ptr.
 bool ATA::IO_SparseZero(u64 byteOffset, u64 byteSize)
 {
 	if (hddSparseBlockValid == false)
@@ -366,8 +418,7 @@ bool ATA::IO_SparseZero(u64 byteOffset, u64 byteSize)
 #endif
 
 		//No, do normal write
-		if (std::fwrite((char*)&hddSparseBlock[byteOffset - HddSparseStart], byteSize, 1, hddImage) != 1 ||
-			std::fflush(hddImage) != 0)
+		if (!IO_WriteAt(byteOffset, &hddSparseBlock[byteOffset - HddSparseStart], byteSize))
 		{
 			Console.Error("DEV9: ATA: File write error");
 			pxAssert(false);
@@ -413,12 +464,6 @@ bool ATA::IO_SparseZero(u64 byteOffset, u64 byteSize)
 	Console.Error("DEV9: ATA: Hole punching not supported on current OS");
 	return false;
 #endif
-	if (FileSystem::FSeek64(hddImage, byteOffset + byteSize, SEEK_SET) != 0)
-	{
-		Console.Error("DEV9: ATA: File seek error");
-		pxAssert(false);
-		abort();
-	}
 	return true;
 }
 
@@ -467,6 +512,14 @@ void ATA::HDD_ReadSync(void (ATA::*drqCMD)())
 	//Set ioWrite false to prevent reading & writing at the same time
 	const bool ioWritePaused = ioWrite;
 	ioWrite = false;
+	//Drop a prefetch the thread hasn't picked up yet, ioThreadIdle_bool can still be set from before it was queued
+	//One already in progress clears ioThreadIdle_bool, so the wait below lets it finish
+	if (ioPrefetch)
+	{
+		ioPrefetch = false;
+		if (ioThreadIdle_bool)
+			prefetchValid = false;
+	}
 
 	//wait until thread waiting
 	ioThreadIdle_cv.wait(ioWaitHandle, [&] { return ioThreadIdle_bool; });
@@ -496,6 +549,11 @@ void ATA::HDD_ReadSync(void (ATA::*drqCMD)())
 
 	IO_Read();
 
+	//Start reading the following sectors while the guest consumes these
+	//Skipped when writes are pending, as the prefetch could read stale data
+	if (!ioWritePaused && writeQueue.IsQueueEmpty())
+		HDD_QueuePrefetch(HDD_GetLBA() + nsector, nsector);
+
 	if (ioWritePaused)
 	{
 		ioWaitHandle.lock();
@@ -507,6 +565,27 @@ void ATA::HDD_ReadSync(void (ATA::*drqCMD)())
 	(this->*drqCMD)();
 }
 
+//Called with ioThread idle and no prefetch queued
+void ATA::HDD_QueuePrefetch(s64 lba, int sectors)
+{
+	prefetchValid = false;
+
+	const s64 maxLBA = std::min<s64>(EmuConfig.DEV9.HddSizeSectors, hddImageSize / 512);
+	sectors = std::min<s64>({sectors, maxPrefetchSectors, maxLBA - lba});
+	if (sectors <= 0)
+		return;
+
+	prefetchLBA = lba;
+	prefetchSectors = sectors;
+	prefetchGeneration = writeGeneration.load();
+
+	{
+		std::lock_guard ioSignallock(ioMutex);
+		ioPrefetch = true;
+	}
+	ioReady.notify_all();
+}
+
 bool ATA::HDD_CanAssessOrSetError()
 {
 	if (!HDD_CanAccess(&nsector))
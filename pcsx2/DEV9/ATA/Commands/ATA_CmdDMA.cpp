@@ -66,6 +66,7 @@ void ATA::PostCmdDMADataFromHost()
 	entry.data = currentWrite;
 	entry.length = currentWriteLength;
 	entry.sector = currentWriteSectors;
+	writeGeneration.fetch_add(1);
 	writeQueue.Enqueue(entry);
 	currentWrite = nullptr;
 	currentWriteLength = 0;
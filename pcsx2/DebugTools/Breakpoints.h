@@ -26,6 +26,7 @@ struct BreakPointCond
 {
 	DebugInterface *debug;
 	PostfixExpression expression;
+	CompiledExpression compiled;
 	char expressionString[128];
 
 	BreakPointCond() : debug(NULL)
@@ -33,10 +34,18 @@ struct BreakPointCond
 		expressionString[0] = '\0';
 	}
 
+	void Compile()
+	{
+		if (!debug->compileExpression(expression,compiled))
+			compiled.ops.clear();
+	}
+
 	u32 Evaluate()
 	{
 		u64 result;
-		if (!debug->parseExpression(expression,result) || result == 0) return 0;
+		// Anything which couldn't be compiled still gets walked the slow way, so it fails the same.
+		const bool valid = compiled.ops.empty() ? debug->parseExpression(expression,result) : debug->evaluateExpression(compiled,result);
+		if (!valid || result == 0) return 0;
 		return 1;
 	}
 };
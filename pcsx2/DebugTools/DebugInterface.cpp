@@ -286,6 +286,18 @@ bool DebugInterface::parseExpression(PostfixExpression& exp, u64& dest)
 	return parsePostfixExpression(exp, &funcs, dest);
 }
 
+bool DebugInterface::compileExpression(const PostfixExpression& exp, CompiledExpression& dest)
+{
+	MipsExpressionFunctions funcs(this);
+	return compilePostfixExpression(exp, &funcs, dest);
+}
+
+bool DebugInterface::evaluateExpression(const CompiledExpression& exp, u64& dest)
+{
+	MipsExpressionFunctions funcs(this);
+	return evaluateCompiledExpression(exp, &funcs, dest);
+}
+
 
 //
 // R5900DebugInterface
@@ -87,6 +87,8 @@ public:
 
 	bool initExpression(const char* exp, PostfixExpression& dest);
 	bool parseExpression(PostfixExpression& exp, u64& dest);
+	bool compileExpression(const PostfixExpression& exp, CompiledExpression& dest);
+	bool evaluateExpression(const CompiledExpression& exp, u64& dest);
 	bool isAlive();
 	bool isCpuPaused();
 	void pauseCpu();
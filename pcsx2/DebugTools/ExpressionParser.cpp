@@ -403,13 +403,136 @@ bool initPostfixExpression(const char* infix, IExpressionFunctions* funcs, Postf
 	return true;
 }
 
+// Applies an operator to its arguments, arg[0] being the one which was on top of the stack.
+static bool applyExpressionOperator(u64 opcode, const u64* arg, bool useFloat, IExpressionFunctions* funcs, u64& result)
+{
+	const float fArg[2] = {static_cast<float>(arg[0]), static_cast<float>(arg[1])};
+
+	switch (opcode)
+	{
+	case EXOP_MEMSIZE:	// must be followed by EXOP_MEM
+		return funcs->getMemoryValue(arg[1],arg[0],result,expressionError);
+	case EXOP_MEM:
+		return funcs->getMemoryValue(arg[0],4,result,expressionError);
+	case EXOP_SIGNPLUS:		// keine aktion ntig
+		result = arg[0];
+		break;
+	case EXOP_SIGNMINUS:	// -0
+		if (useFloat)
+			result = 0.0-fArg[0];
+		else
+			result = 0-arg[0];
+		break;
+	case EXOP_BITNOT:			// ~b
+		result = ~arg[0];
+		break;
+	case EXOP_LOGNOT:			// !b
+		result = !arg[0];
+		break;
+	case EXOP_MUL:			// a*b
+		if (useFloat)
+			result = fArg[1]*fArg[0];
+		else
+			result = arg[1]*arg[0];
+		break;
+	case EXOP_DIV:			// a/b
+		if (arg[0] == 0)
+		{
+			sprintf(expressionError,"Division by zero");
+			return false;
+		}
+		if (useFloat)
+			result = fArg[1]/fArg[0];
+		else
+			result = arg[1]/arg[0];
+		break;
+	case EXOP_MOD:			// a%b
+		if (arg[0] == 0)
+		{
+			sprintf(expressionError,"Modulo by zero");
+			return false;
+		}
+		result = arg[1]%arg[0];
+		break;
+	case EXOP_ADD:			// a+b
+		if (useFloat)
+			result = fArg[1]+fArg[0];
+		else
+			result = arg[1]+arg[0];
+		break;
+	case EXOP_SUB:			// a-b
+		if (useFloat)
+			result = fArg[1]-fArg[0];
+		else
+			result = arg[1]-arg[0];
+		break;
+	case EXOP_SHL:			// a<<b
+		result = arg[1]<<arg[0];
+		break;
+	case EXOP_SHR:			// a>>b
+		result = arg[1]>>arg[0];
+		break;
+	case EXOP_GREATEREQUAL:		// a >= b
+		if (useFloat)
+			result = fArg[1]>=fArg[0];
+		else
+			result = arg[1]>=arg[0];
+		break;
+	case EXOP_GREATER:			// a > b
+		if (useFloat)
+			result = fArg[1]>fArg[0];
+		else
+			result = arg[1]>arg[0];
+		break;
+	case EXOP_LOWEREQUAL:		// a <= b
+		if (useFloat)
+			result = fArg[1]<=fArg[0];
+		else
+			result = arg[1]<=arg[0];
+		break;
+	case EXOP_LOWER:			// a < b
+		if (useFloat)
+			result = fArg[1]<fArg[0];
+		else
+			result = arg[1]<arg[0];
+		break;
+	case EXOP_EQUAL:		// a == b
+		result = arg[1]==arg[0];
+		break;
+	case EXOP_NOTEQUAL:			// a != b
+		result = arg[1]!=arg[0];
+		break;
+	case EXOP_BITAND:			// a&b
+		result = arg[1]&arg[0];
+		break;
+	case EXOP_XOR:			// a^b
+		result = arg[1]^arg[0];
+		break;
+	case EXOP_BITOR:			// a|b
+		result = arg[1]|arg[0];
+		break;
+	case EXOP_LOGAND:			// a && b
+		result = arg[1]&&arg[0];
+		break;
+	case EXOP_LOGOR:			// a || b
+		result = arg[1]||arg[0];
+		break;
+	case EXOP_TERTELSE:			// exp ? exp : exp, else muss zuerst kommen!
+		result = arg[2]?arg[1]:arg[0];
+		break;
+	default:			// EXOP_TERTIF darf so nicht vorkommen
+		return false;
+	}
+
+	return true;
+}
+
 bool parsePostfixExpression(PostfixExpression& exp, IExpressionFunctions* funcs, u64& dest)
 {
 	size_t num = 0;
 	u64 opcode;
 	std::vector<u64> valueStack;
-	u64 arg[5] = {0};
-	float fArg[5] = {0};
+	u64 arg[3] = {0};
 	bool useFloat = false;
 
 	while (num < exp.size())
@@ -430,7 +553,7 @@ bool parsePostfixExpression(PostfixExpression& exp, IExpressionFunctions* funcs,
 			break;
 		case EXCOMM_OP:	// opcode
 			opcode = exp[num++].second;
-			if (valueStack.size() < ExpressionOpcodes[opcode].args)
+			if (opcode >= EXOP_COUNT || valueStack.size() < ExpressionOpcodes[opcode].args)
 			{
 				sprintf(expressionError,"Not enough arguments");
 				return false;
@@ -438,149 +561,24 @@ bool parsePostfixExpression(PostfixExpression& exp, IExpressionFunctions* funcs,
 			for (int l = 0; l < ExpressionOpcodes[opcode].args; l++)
 			{
 				arg[l] = valueStack[valueStack.size()-1];
-				fArg[l] = arg[l];
 				valueStack.pop_back();
 			}
 
-			switch (opcode)
+			if (opcode == EXOP_MEMSIZE && (num >= exp.size() || exp[num++].second != EXOP_MEM))
 			{
-			case EXOP_MEMSIZE:	// must be followed by EXOP_MEM
-				if (exp[num++].second != EXOP_MEM)
-				{
-					sprintf(expressionError,"Invalid memsize operator");
-					return false;
-				}
-
-				u64 val;
-				if(!funcs->getMemoryValue(arg[1],arg[0],val,expressionError))
-				{
-					return false;
-				}
-				valueStack.push_back(val);
-				break;
-			case EXOP_MEM:
-				{
-					u64 val;
-					if (!funcs->getMemoryValue(arg[0],4,val,expressionError))
-					{
-						return false;
-					}
-					valueStack.push_back(val);
-				}
-				break;
-			case EXOP_SIGNPLUS:		// keine aktion ntig
-				break;
-			case EXOP_SIGNMINUS:	// -0
-				if (useFloat)
-					valueStack.push_back(0.0-fArg[0]);
-				else
-					valueStack.push_back(0-arg[0]);
-				break;
-			case EXOP_BITNOT:			// ~b
-				valueStack.push_back(~arg[0]);
-				break;
-			case EXOP_LOGNOT:			// !b
-				valueStack.push_back(!arg[0]);
-				break;
-			case EXOP_MUL:			// a*b
-				if (useFloat)
-					valueStack.push_back(fArg[1]*fArg[0]);
-				else
-					valueStack.push_back(arg[1]*arg[0]);
-				break;
-			case EXOP_DIV:			// a/b
-				if (arg[0] == 0)
-				{
-					sprintf(expressionError,"Division by zero");
-					return false;
-				}
-				if (useFloat)
-					valueStack.push_back(fArg[1]/fArg[0]);
-				else
-					valueStack.push_back(arg[1]/arg[0]);
-				break;
-			case EXOP_MOD:			// a%b
-				if (arg[0] == 0)
-				{
-					sprintf(expressionError,"Modulo by zero");
-					return false;
-				}
-				valueStack.push_back(arg[1]%arg[0]);
-				break;
-			case EXOP_ADD:			// a+b
-				if (useFloat)
-					valueStack.push_back(fArg[1]+fArg[0]);
-				else
-					valueStack.push_back(arg[1]+arg[0]);
-				break;
-			case EXOP_SUB:			// a-b
-				if (useFloat)
-					valueStack.push_back(fArg[1]-fArg[0]);
-				else
-					valueStack.push_back(arg[1]-arg[0]);
-				break;
-			case EXOP_SHL:			// a<<b
-				valueStack.push_back(arg[1]<<arg[0]);
-				break;
-			case EXOP_SHR:			// a>>b
-				valueStack.push_back(arg[1]>>arg[0]);
-				break;
-			case EXOP_GREATEREQUAL:		// a >= b
-				if (useFloat)
-					valueStack.push_back(fArg[1]>=fArg[0]);
-				else
-					valueStack.push_back(arg[1]>=arg[0]);
-				break;
-			case EXOP_GREATER:			// a > b
-				if (useFloat)
-					valueStack.push_back(fArg[1]>fArg[0]);
-				else
-					valueStack.push_back(arg[1]>arg[0]);
-				break;
-			case EXOP_LOWEREQUAL:		// a <= b
-				if (useFloat)
-					valueStack.push_back(fArg[1]<=fArg[0]);
-				else
-					valueStack.push_back(arg[1]<=arg[0]);
-				break;
-			case EXOP_LOWER:			// a < b
-				if (useFloat)
-					valueStack.push_back(fArg[1]<fArg[0]);
-				else
-					valueStack.push_back(arg[1]<arg[0]);
-				break;
-			case EXOP_EQUAL:		// a == b
-				valueStack.push_back(arg[1]==arg[0]);
-				break;
-			case EXOP_NOTEQUAL:			// a != b
-				valueStack.push_back(arg[1]!=arg[0]);
-				break;
-			case EXOP_BITAND:			// a&b
-				valueStack.push_back(arg[1]&arg[0]);
-				break;
-			case EXOP_XOR:			// a^b
-				valueStack.push_back(arg[1]^arg[0]);
-				break;
-			case EXOP_BITOR:			// a|b
-				valueStack.push_back(arg[1]|arg[0]);
-				break;
-			case EXOP_LOGAND:			// a && b
-				valueStack.push_back(arg[1]&&arg[0]);
-				break;
-			case EXOP_LOGOR:			// a || b
-				valueStack.push_back(arg[1]||arg[0]);
-				break;
-			case EXOP_TERTIF:			// darf so nicht vorkommen
+				sprintf(expressionError,"Invalid memsize operator");
 				return false;
-			case EXOP_TERTELSE:			// exp ? exp : exp, else muss zuerst kommen!
-				if (exp[num++].second != EXOP_TERTIF)
-				{
-					sprintf(expressionError,"Invalid tertiary operator");
-					return false;
-				}
-				valueStack.push_back(arg[2]?arg[1]:arg[0]);
-				break;
 			}
+			if (opcode == EXOP_TERTELSE && (num >= exp.size() || exp[num++].second != EXOP_TERTIF))
+			{
+				sprintf(expressionError,"Invalid tertiary operator");
+				return false;
+			}
+
+			u64 val;
+			if (!applyExpressionOperator(opcode,arg,useFloat,funcs,val))
+				return false;
+			valueStack.push_back(val);
 			break;
 		}
 	}
@@ -590,6 +588,104 @@ bool parsePostfixExpression(PostfixExpression& exp, IExpressionFunctions* funcs,
 	return true;
 }
 
+bool compilePostfixExpression(const PostfixExpression& exp, IExpressionFunctions* funcs, CompiledExpression& dest)
+{
+	// Everything which doesn't depend on register or memory values is checked here, so the
+	// evaluation loop only has to do the arithmetic. Whether float maths is used only depends
+	// on the constants and references before an operator, so that gets resolved here too.
+	dest.ops.clear();
+	u32 depth = 0;
+	bool useFloat = false;
+
+	for (size_t num = 0; num < exp.size(); num++)
+	{
+		CompiledExpression::Op op = {};
+		switch (exp[num].first)
+		{
+		case EXCOMM_CONST_FLOAT:
+			useFloat = true;
+			[[fallthrough]];
+		case EXCOMM_CONST:
+			op.code = CompiledExpression::CONST;
+			op.value = exp[num].second;
+			depth++;
+			break;
+		case EXCOMM_REF:
+			useFloat = useFloat || funcs->getReferenceType(exp[num].second) == EXPR_TYPE_FLOAT;
+			op.code = CompiledExpression::REF;
+			op.value = exp[num].second;
+			depth++;
+			break;
+		case EXCOMM_OP:
+			if (exp[num].second >= EXOP_COUNT || exp[num].second == EXOP_TERTIF || depth < ExpressionOpcodes[exp[num].second].args)
+			{
+				sprintf(expressionError,"Not enough arguments");
+				return false;
+			}
+			op.code = static_cast<u8>(exp[num].second);
+			if (op.code == EXOP_MEMSIZE && (++num >= exp.size() || exp[num].second != EXOP_MEM))
+			{
+				sprintf(expressionError,"Invalid memsize operator");
+				return false;
+			}
+			if (op.code == EXOP_TERTELSE && (++num >= exp.size() || exp[num].second != EXOP_TERTIF))
+			{
+				sprintf(expressionError,"Invalid tertiary operator");
+				return false;
+			}
+			depth = depth - ExpressionOpcodes[op.code].args + 1;
+			break;
+		default:
+			return false;
+		}
+
+		if (depth > CompiledExpression::MAX_DEPTH)
+		{
+			sprintf(expressionError,"Expression too complex");
+			return false;
+		}
+
+		op.useFloat = useFloat;
+		dest.ops.push_back(op);
+	}
+
+	return depth == 1;
+}
+
+bool evaluateCompiledExpression(const CompiledExpression& exp, IExpressionFunctions* funcs, u64& dest)
+{
+	if (exp.ops.empty())
+		return false;
+
+	u64 valueStack[CompiledExpression::MAX_DEPTH];
+	u64 arg[3] = {0};
+	u32 depth = 0;
+
+	for (const CompiledExpression::Op& op : exp.ops)
+	{
+		if (op.code == CompiledExpression::CONST)
+		{
+			valueStack[depth++] = op.value;
+		}
+		else if (op.code == CompiledExpression::REF)
+		{
+			valueStack[depth++] = funcs->getReferenceValue(op.value);
+		}
+		else
+		{
+			for (int l = 0; l < ExpressionOpcodes[op.code].args; l++)
+				arg[l] = valueStack[--depth];
+
+			if (!applyExpressionOperator(op.code,arg,op.useFloat,funcs,valueStack[depth]))
+				return false;
+			depth++;
+		}
+	}
+
+	dest = valueStack[0];
+	return true;
+}
+
 bool parseExpression(char* exp, IExpressionFunctions* funcs, u64& dest)
 {
 	PostfixExpression postfix;
@@ -37,7 +37,31 @@ public:
 	virtual bool getMemoryValue(u32 address, int size, u64& dest, char* error) = 0;
 };
 
+// A postfix expression which has been checked up front, so it can be evaluated over and over
+// (e.g. as a breakpoint condition) without allocating or re-validating anything.
+struct CompiledExpression
+{
+	enum : u8
+	{
+		CONST = 0xFE,
+		REF = 0xFF,
+	};
+
+	static constexpr u32 MAX_DEPTH = 32;
+
+	struct Op
+	{
+		u8 code; // operator, CONST or REF
+		bool useFloat;
+		u64 value;
+	};
+
+	std::vector<Op> ops;
+};
+
 bool initPostfixExpression(const char* infix, IExpressionFunctions* funcs, PostfixExpression& dest);
 bool parsePostfixExpression(PostfixExpression& exp, IExpressionFunctions* funcs, u64& dest);
+bool compilePostfixExpression(const PostfixExpression& exp, IExpressionFunctions* funcs, CompiledExpression& dest);
+bool evaluateCompiledExpression(const CompiledExpression& exp, IExpressionFunctions* funcs, u64& dest);
 bool parseExpression(const char* exp, IExpressionFunctions* funcs, u64& dest);
 const char* getExpressionError();
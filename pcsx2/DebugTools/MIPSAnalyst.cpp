@@ -21,9 +21,56 @@
 #include "DebugInterface.h"
 #include "R5900.h"
 #include "R5900OpcodeTables.h"
+#include "Config.h"
+
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
+
+#include "fmt/core.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <zlib.h>
 
 static std::vector<MIPSAnalyst::AnalyzedFunction> functions;
 
+// Background scanning, see ScanForFunctionsAsync().
+static std::mutex s_scan_mutex;
+static std::thread s_scan_thread;
+static std::atomic_bool s_scan_cancelled{false};
+static std::atomic_bool s_scan_running{false};
+
+// The scanner thread works on a copy of the code taken on the CPU thread, instead of reading EE
+// memory while the game runs. Null for scans on the CPU thread itself, which read memory directly.
+static thread_local const std::vector<u32>* s_scan_code = nullptr;
+static thread_local u32 s_scan_code_start = 0;
+
+// Found functions are added to the map every this many bytes scanned, so a background scan shows
+// results as it goes, without the map rebuilding its lookups after every single function.
+static constexpr u32 SCAN_CHUNK_SIZE = 0x10000;
+
+// Scan results are cached on disk per ELF CRC, along with a checksum of each page of code they were
+// found in. Pages which don't match any more are scanned again, the rest come from the cache.
+static constexpr u32 FUNCTION_CACHE_SIGNATURE = 0x434E5546; // FUNC
+static constexpr u32 FUNCTION_CACHE_VERSION = 2;
+
+// Same granularity as the recompiler's write tracking, which recClear() reports changes with.
+static constexpr u32 SCAN_PAGE_SIZE = 0x1000;
+
+// Pages of the scanned range which were written since they were scanned, CPU thread only.
+static SymbolMap* s_invalidate_map = nullptr;
+static u32 s_invalidate_start = 0;
+static u32 s_invalidate_end = 0;
+static std::vector<bool> s_invalidated_pages;
+static bool s_has_invalidated_pages = false;
+static u32 s_vsyncs_since_rescan = 0;
+
+// Invalidated pages are rescanned at most this often, for games which keep writing to their code.
+static constexpr u32 RESCAN_INTERVAL_VSYNCS = 60;
+
 #define MIPS_MAKE_J(addr)   (0x08000000 | ((addr)>>2))
 #define MIPS_MAKE_JAL(addr) (0x0C000000 | ((addr)>>2))
 #define MIPS_MAKE_JR_RA()   (0x03e00008)
@@ -39,9 +86,19 @@ static std::vector<MIPSAnalyst::AnalyzedFunction> functions;
 
 namespace MIPSAnalyst
 {
+	static u32 ReadScanOp(u32 addr)
+	{
+		if (!s_scan_code)
+			return r5900Debug.read32(addr);
+
+		// Anything outside the copied range reads as a nop.
+		const u32 index = (addr - s_scan_code_start) / 4;
+		return (addr >= s_scan_code_start && index < s_scan_code->size()) ? (*s_scan_code)[index] : 0;
+	}
+
 	u32 GetJumpTarget(u32 addr)
 	{
-		u32 op = r5900Debug.read32(addr);
+		u32 op = ReadScanOp(addr);
 		const R5900::OPCODE& opcode = R5900::GetInstruction(op);
 
 		if ((opcode.flags & IS_BRANCH) && (opcode.flags & BRANCHTYPE_MASK) == BRANCHTYPE_JUMP)
@@ -55,7 +112,7 @@ namespace MIPSAnalyst
 
 	u32 GetBranchTarget(u32 addr)
 	{
-		u32 op = r5900Debug.read32(addr);
+		u32 op = ReadScanOp(addr);
 		const R5900::OPCODE& opcode = R5900::GetInstruction(op);
 
 		int branchType = (opcode.flags & BRANCHTYPE_MASK);
@@ -67,7 +124,7 @@ namespace MIPSAnalyst
 
 	u32 GetBranchTargetNoRA(u32 addr)
 	{
-		u32 op = r5900Debug.read32(addr);
+		u32 op = ReadScanOp(addr);
 		const R5900::OPCODE& opcode = R5900::GetInstruction(op);
 
 		int branchType = (opcode.flags & BRANCHTYPE_MASK);
@@ -84,7 +141,7 @@ namespace MIPSAnalyst
 
 	u32 GetSureBranchTarget(u32 addr)
 	{
-		u32 op = r5900Debug.read32(addr);
+		u32 op = ReadScanOp(addr);
 		const R5900::OPCODE& opcode = R5900::GetInstruction(op);
 
 		if ((opcode.flags & IS_BRANCH) && (opcode.flags & BRANCHTYPE_MASK) == BRANCHTYPE_BRANCH)
@@ -155,7 +212,7 @@ namespace MIPSAnalyst
 		u32 furthestJumpbackAddr = INVALIDTARGET;
 
 		for (u32 ahead = fromAddr; ahead < fromAddr + MAX_AHEAD_SCAN; ahead += 4) {
-			u32 aheadOp = r5900Debug.read32(ahead);
+			u32 aheadOp = ReadScanOp(ahead);
 			u32 target = GetBranchTargetNoRA(ahead);
 			if (target == INVALIDTARGET && ((aheadOp & 0xFC000000) == 0x08000000)) {
 				target = GetJumpTarget(ahead);
@@ -179,7 +236,7 @@ namespace MIPSAnalyst
 
 		if (closestJumpbackAddr != INVALIDTARGET && furthestJumpbackAddr == INVALIDTARGET) {
 			for (u32 behind = closestJumpbackTarget; behind < fromAddr; behind += 4) {
-				u32 behindOp = r5900Debug.read32(behind);
+				u32 behindOp = ReadScanOp(behind);
 				u32 target = GetBranchTargetNoRA(behind);
 				if (target == INVALIDTARGET && ((behindOp & 0xFC000000) == 0x08000000)) {
 					target = GetJumpTarget(behind);
@@ -196,6 +253,16 @@ namespace MIPSAnalyst
 		return furthestJumpbackAddr;
 	}
 
+	static void InsertFunctions(SymbolMap& map, size_t first, bool insertSymbols) {
+		for (auto iter = functions.begin() + first; iter != functions.end(); iter++) {
+			iter->size = iter->end - iter->start + 4;
+			if (insertSymbols) {
+				char temp[256];
+				map.AddFunction(DefaultFunctionName(temp, iter->start), iter->start, iter->end - iter->start + 4);
+			}
+		}
+	}
+
 	void ScanForFunctions(SymbolMap& map, u32 startAddr, u32 endAddr, bool insertSymbols) {
 		AnalyzedFunction currentFunction = {startAddr};
 
@@ -205,9 +272,20 @@ namespace MIPSAnalyst
 		bool isStraightLeaf = true;
 
 		functions.clear();
+		size_t inserted = 0;
+		u32 nextChunk = startAddr + SCAN_CHUNK_SIZE;
 
 		u32 addr;
 		for (addr = startAddr; addr <= endAddr; addr += 4) {
+			if (addr >= nextChunk) {
+				if (s_scan_cancelled.load(std::memory_order_relaxed))
+					return;
+
+				InsertFunctions(map, inserted, insertSymbols);
+				inserted = functions.size();
+				nextChunk = addr + SCAN_CHUNK_SIZE;
+			}
+
 			// Use pre-existing symbol map info if available. May be more reliable.
 			SymbolInfo syminfo;
 			if (map.GetSymbolInfo(&syminfo, addr, ST_FUNCTION)) {
@@ -224,7 +302,7 @@ namespace MIPSAnalyst
 				continue;
 			}
 
-			u32 op = r5900Debug.read32(addr);
+			u32 op = ReadScanOp(addr);
 
 			u32 target = GetBranchTargetNoRA(addr);
 			if (target != INVALIDTARGET) {
@@ -294,7 +372,7 @@ namespace MIPSAnalyst
 			if (end) {
 				// most functions are aligned to 8 or 16 bytes
 				// add the padding to this one
-				while (((addr+8) % 16)  && r5900Debug.read32(addr+8) == 0)
+				while (((addr+8) % 16)  && ReadScanOp(addr+8) == 0)
 					addr += 4;
 
 				currentFunction.end = addr + 4;
@@ -312,14 +390,286 @@ namespace MIPSAnalyst
 
 		currentFunction.end = addr + 4;
 		functions.push_back(currentFunction);
+		InsertFunctions(map, inserted, insertSymbols);
+	}
 
-		for (auto iter = functions.begin(); iter != functions.end(); iter++) {
-			iter->size = iter->end - iter->start + 4;
-			if (insertSymbols) {
-				char temp[256];
-				map.AddFunction(DefaultFunctionName(temp, iter->start), iter->start, iter->end - iter->start + 4);
-			}
+	struct FunctionCacheHeader {
+		u32 signature;
+		u32 version;
+		u32 startAddr;
+		u32 endAddr;
+		u32 pageCount;
+		u32 count;
+	};
+
+	struct FunctionCacheEntry {
+		u32 start;
+		u32 size;
+	};
+
+	static u32 GetPageCount(u32 startAddr, u32 endAddr) {
+		return (endAddr - (startAddr & ~(SCAN_PAGE_SIZE - 1))) / SCAN_PAGE_SIZE + 1;
+	}
+
+	static u32 GetPageIndex(u32 startAddr, u32 addr) {
+		return (addr - (startAddr & ~(SCAN_PAGE_SIZE - 1))) / SCAN_PAGE_SIZE;
+	}
+
+	static std::vector<u32> CalculatePageChecksums(const std::vector<u32>& code, u32 startAddr, u32 endAddr) {
+		std::vector<u32> checksums(GetPageCount(startAddr, endAddr));
+		for (size_t i = 0; i < code.size();) {
+			const u32 addr = startAddr + static_cast<u32>(i) * 4;
+			const size_t words = std::min<size_t>((SCAN_PAGE_SIZE - (addr & (SCAN_PAGE_SIZE - 1))) / 4, code.size() - i);
+			checksums[GetPageIndex(startAddr, addr)] = crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef*>(&code[i]), static_cast<uInt>(words * 4));
+			i += words;
+		}
+
+		return checksums;
+	}
+
+	static std::string GetFunctionCacheDirectory() {
+		return Path::Combine(EmuFolders::Cache, "functions");
+	}
+
+	static std::string GetFunctionCachePath(u32 crc) {
+		return Path::Combine(GetFunctionCacheDirectory(), fmt::format("{:08X}.cache", crc));
+	}
+
+	// Adds the cached functions which only cover unchanged pages, and marks the other pages for scanning.
+	static void LoadCachedFunctions(SymbolMap& map, u32 startAddr, u32 endAddr, u32 crc, const std::vector<u32>& checksums,
+		std::vector<bool>* rescan, std::vector<AnalyzedFunction>* found) {
+		if (crc == 0 || EmuFolders::Cache.empty())
+			return;
+
+		const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(GetFunctionCachePath(crc).c_str());
+		if (!data.has_value() || data->size() < sizeof(FunctionCacheHeader))
+			return;
+
+		FunctionCacheHeader header;
+		std::memcpy(&header, data->data(), sizeof(header));
+		if (header.signature != FUNCTION_CACHE_SIGNATURE || header.version != FUNCTION_CACHE_VERSION ||
+			header.startAddr != startAddr || header.endAddr != endAddr || header.pageCount != checksums.size() ||
+			data->size() != sizeof(header) + sizeof(u32) * static_cast<size_t>(header.pageCount) +
+								sizeof(FunctionCacheEntry) * static_cast<size_t>(header.count)) {
+			return;
+		}
+
+		const u8* ptr = data->data() + sizeof(header);
+		for (u32 i = 0; i < header.pageCount; i++, ptr += sizeof(u32)) {
+			u32 checksum;
+			std::memcpy(&checksum, ptr, sizeof(checksum));
+			(*rescan)[i] = (checksum != checksums[i]);
+		}
+
+		for (u32 i = 0; i < header.count; i++, ptr += sizeof(FunctionCacheEntry)) {
+			FunctionCacheEntry entry;
+			std::memcpy(&entry, ptr, sizeof(entry));
+			if (entry.size == 0 || entry.start < startAddr || entry.start + entry.size - 4 > endAddr)
+				continue;
+
+			bool valid = true;
+			for (u32 page = GetPageIndex(startAddr, entry.start); valid && page <= GetPageIndex(startAddr, entry.start + entry.size - 4); page++)
+				valid = !(*rescan)[page];
+			if (!valid)
+				continue;
+
+			AnalyzedFunction function = {};
+			function.start = entry.start;
+			function.end = entry.start + entry.size - 4;
+			function.size = entry.size;
+			found->push_back(function);
+
+			// Functions which came from the ELF or a .sym file keep their own size.
+			if (map.GetFunctionSize(entry.start) != SymbolMap::INVALID_ADDRESS)
+				continue;
+
+			char temp[256];
+			map.AddFunction(DefaultFunctionName(temp, entry.start), entry.start, entry.size);
+		}
+	}
+
+	static void SaveCachedFunctions(u32 startAddr, u32 endAddr, u32 crc, const std::vector<u32>& checksums,
+		const std::vector<AnalyzedFunction>& found) {
+		if (crc == 0 || EmuFolders::Cache.empty())
+			return;
+
+		const FunctionCacheHeader header = {FUNCTION_CACHE_SIGNATURE, FUNCTION_CACHE_VERSION, startAddr, endAddr,
+			static_cast<u32>(checksums.size()), static_cast<u32>(found.size())};
+		std::vector<u8> data(sizeof(header) + sizeof(u32) * checksums.size() + sizeof(FunctionCacheEntry) * found.size());
+		u8* ptr = data.data();
+		std::memcpy(ptr, &header, sizeof(header));
+		ptr += sizeof(header);
+		std::memcpy(ptr, checksums.data(), sizeof(u32) * checksums.size());
+		ptr += sizeof(u32) * checksums.size();
+		for (const AnalyzedFunction& function : found) {
+			const FunctionCacheEntry entry = {function.start, function.size};
+			std::memcpy(ptr, &entry, sizeof(entry));
+			ptr += sizeof(entry);
+		}
+
+		const std::string path = GetFunctionCachePath(crc);
+		if (!FileSystem::EnsureDirectoryExists(GetFunctionCacheDirectory().c_str(), false) ||
+			!FileSystem::WriteBinaryFile(path.c_str(), data.data(), data.size())) {
+			Console.Warning("(MIPSAnalyst) Failed to write function cache '%s'", path.c_str());
+		}
+	}
+
+	// Scans each run of marked pages on its own. Returns false if the scan was cancelled.
+	static bool ScanPages(SymbolMap& map, u32 startAddr, u32 endAddr, const std::vector<bool>& pages,
+		std::vector<AnalyzedFunction>* found) {
+		const u32 pageBase = startAddr & ~(SCAN_PAGE_SIZE - 1);
+		for (u32 first = 0; first < pages.size(); first++) {
+			if (!pages[first])
+				continue;
+
+			u32 last = first;
+			while (last + 1 < pages.size() && pages[last + 1])
+				last++;
+
+			const u32 runStart = std::max(startAddr, pageBase + first * SCAN_PAGE_SIZE);
+			const u32 runEnd = std::min(endAddr, pageBase + (last + 1) * SCAN_PAGE_SIZE - 4);
+			ScanForFunctions(map, runStart, runEnd, true);
+			if (s_scan_cancelled.load(std::memory_order_relaxed))
+				return false;
+
+			found->insert(found->end(), functions.begin(), functions.end());
+			first = last;
 		}
+
+		return true;
+	}
+
+	static void ScanForFunctionsThread(SymbolMap* map, u32 startAddr, u32 endAddr, u32 crc, std::vector<u32> code) {
+		Threading::SetNameOfCurrentThread("Function Scanner");
+
+		Common::Timer timer;
+		const std::vector<u32> checksums = CalculatePageChecksums(code, startAddr, endAddr);
+		std::vector<bool> rescan(checksums.size(), true);
+		std::vector<AnalyzedFunction> found;
+		LoadCachedFunctions(*map, startAddr, endAddr, crc, checksums, &rescan, &found);
+		const size_t cached = found.size();
+
+		s_scan_code = &code;
+		s_scan_code_start = startAddr;
+		const bool completed = ScanPages(*map, startAddr, endAddr, rescan, &found);
+		s_scan_code = nullptr;
+
+		if (completed) {
+			if (std::find(rescan.begin(), rescan.end(), true) != rescan.end())
+				SaveCachedFunctions(startAddr, endAddr, crc, checksums, found);
+
+			map->UpdateActiveSymbols();
+			DevCon.WriteLn("(MIPSAnalyst) %zu cached and %zu scanned functions for %08X-%08X in %.2f ms", cached,
+				found.size() - cached, startAddr, endAddr, timer.GetTimeMilliseconds());
+		}
+
+		s_scan_running.store(false, std::memory_order_release);
+	}
+
+	static void RescanFunctionsThread(SymbolMap* map, u32 startAddr, u32 endAddr, std::vector<u32> code, std::vector<bool> pages) {
+		Threading::SetNameOfCurrentThread("Function Scanner");
+
+		// Drop what the scanner found in the written pages before, but keep anything named by the user or the ELF.
+		for (const SymbolEntry& symbol : map->GetAllSymbols(ST_FUNCTION)) {
+			if (symbol.address < startAddr || symbol.address > endAddr || !pages[GetPageIndex(startAddr, symbol.address)])
+				continue;
+
+			char temp[256];
+			if (symbol.name == DefaultFunctionName(temp, symbol.address))
+				map->RemoveFunction(symbol.address, true);
+		}
+
+		std::vector<AnalyzedFunction> found;
+		s_scan_code = &code;
+		s_scan_code_start = startAddr;
+		if (ScanPages(*map, startAddr, endAddr, pages, &found)) {
+			map->UpdateActiveSymbols();
+			DevCon.WriteLn("(MIPSAnalyst) Rescanned %zu functions in written pages of %08X-%08X", found.size(), startAddr, endAddr);
+		}
+		s_scan_code = nullptr;
+
+		s_scan_running.store(false, std::memory_order_release);
+	}
+
+	// s_scan_mutex must be held.
+	static void StopScanThread() {
+		if (!s_scan_thread.joinable())
+			return;
+
+		s_scan_cancelled.store(true, std::memory_order_relaxed);
+		s_scan_thread.join();
+		s_scan_cancelled.store(false, std::memory_order_relaxed);
+		s_scan_running.store(false, std::memory_order_relaxed);
+	}
+
+	static std::vector<u32> CopyScanRange(u32 startAddr, u32 endAddr) {
+		std::vector<u32> code;
+		if (endAddr >= startAddr) {
+			code.reserve((endAddr - startAddr) / 4 + 1);
+			for (u32 addr = startAddr; addr <= endAddr && addr >= startAddr; addr += 4)
+				code.push_back(r5900Debug.read32(addr));
+		}
+
+		return code;
+	}
+
+	void ScanForFunctionsAsync(SymbolMap& map, u32 startAddr, u32 endAddr, u32 crc) {
+		std::vector<u32> code = CopyScanRange(startAddr, endAddr);
+
+		std::unique_lock lock(s_scan_mutex);
+		StopScanThread();
+
+		s_invalidate_map = (endAddr >= startAddr) ? &map : nullptr;
+		s_invalidate_start = startAddr;
+		s_invalidate_end = endAddr;
+		s_invalidated_pages.assign(s_invalidate_map ? GetPageCount(startAddr, endAddr) : 0, false);
+		s_has_invalidated_pages = false;
+		if (!s_invalidate_map)
+			return;
+
+		s_scan_running.store(true, std::memory_order_relaxed);
+		s_scan_thread = std::thread(ScanForFunctionsThread, &map, startAddr, endAddr, crc, std::move(code));
+	}
+
+	void InvalidateScannedCode(u32 addr, u32 size) {
+		// recClear() passes physical addresses.
+		const u32 start = s_invalidate_start & 0x1fffffff;
+		const u32 end = s_invalidate_end & 0x1fffffff;
+		if (!s_invalidate_map || size == 0 || addr > end || addr + size * 4 <= start)
+			return;
+
+		const u32 first = GetPageIndex(start, std::max(addr, start));
+		const u32 last = GetPageIndex(start, std::min(addr + size * 4 - 4, end));
+		for (u32 page = first; page <= last; page++)
+			s_invalidated_pages[page] = true;
+		s_has_invalidated_pages = true;
+	}
+
+	void RescanInvalidatedFunctions() {
+		if (!s_has_invalidated_pages || ++s_vsyncs_since_rescan < RESCAN_INTERVAL_VSYNCS ||
+			s_scan_running.load(std::memory_order_acquire)) {
+			return;
+		}
+
+		std::vector<u32> code = CopyScanRange(s_invalidate_start, s_invalidate_end);
+		std::vector<bool> pages(s_invalidated_pages.size(), false);
+		pages.swap(s_invalidated_pages);
+		s_has_invalidated_pages = false;
+		s_vsyncs_since_rescan = 0;
+
+		std::unique_lock lock(s_scan_mutex);
+		StopScanThread();
+		s_scan_running.store(true, std::memory_order_relaxed);
+		s_scan_thread = std::thread(RescanFunctionsThread, s_invalidate_map, s_invalidate_start, s_invalidate_end, std::move(code), std::move(pages));
+	}
+
+	void CancelFunctionScan() {
+		std::unique_lock lock(s_scan_mutex);
+		StopScanThread();
+
+		s_invalidate_map = nullptr;
+		s_invalidated_pages.clear();
+		s_has_invalidated_pages = false;
 	}
 
 	MipsOpcodeInfo GetOpcodeInfo(DebugInterface* cpu, u32 address) {
@@ -43,6 +43,22 @@ namespace MIPSAnalyst
 
 	void ScanForFunctions(SymbolMap& map, u32 startAddr, u32 endAddr, bool insertSymbols);
 
+	// Scans and inserts functions on a worker thread, adding them to the map as they're found.
+	// Must be called on the CPU thread, the range is copied before the scan starts. Results are
+	// cached on disk per ELF CRC, and only pages whose code changed since are scanned again.
+	void ScanForFunctionsAsync(SymbolMap& map, u32 startAddr, u32 endAddr, u32 crc);
+
+	// Called by recClear() for the physical words it clears, marks those pages of the range passed
+	// to ScanForFunctionsAsync() for scanning again. CPU thread only.
+	void InvalidateScannedCode(u32 addr, u32 size);
+
+	// Rescans the pages written since they were last scanned on the worker thread. Called on the
+	// CPU thread every vsync, does nothing most of the time.
+	void RescanInvalidatedFunctions();
+
+	// Stops a background scan, if one is running, and waits for it to exit.
+	void CancelFunctionScan();
+
 	enum LoadStoreLRType { LOADSTORE_NORMAL, LOADSTORE_LEFT, LOADSTORE_RIGHT };
 
 	typedef struct {
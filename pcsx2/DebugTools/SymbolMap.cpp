@@ -15,6 +15,7 @@
 
 #include "PrecompiledHeader.h"
 #include "common/FileSystem.h"
+#include "common/StringUtil.h"
 
 #include "SymbolMap.h"
 #include <algorithm>
@@ -28,6 +29,63 @@ SymbolMap R3000SymbolMap;
 
 #define ARRAY_SIZE(x) (sizeof((x))/sizeof(*(x)))
 
+template <typename T>
+static void SortActiveSymbols(std::vector<T>& symbols) {
+	// Stable, so the first symbol at an address wins, same as map inserts did.
+	std::stable_sort(symbols.begin(), symbols.end(), [](const T& lhs, const T& rhs) { return lhs.address < rhs.address; });
+	symbols.erase(std::unique(symbols.begin(), symbols.end(), [](const T& lhs, const T& rhs) { return lhs.address == rhs.address; }), symbols.end());
+}
+
+template <typename T>
+static void AssignMaxEnds(std::vector<T>& symbols) {
+	u64 maxEnd = 0;
+	for (T& symbol : symbols) {
+		maxEnd = std::max(maxEnd, static_cast<u64>(symbol.address) + symbol.entry->size);
+		symbol.maxEnd = maxEnd;
+	}
+}
+
+// Adds a new symbol to an up to date view without rebuilding it, so lookups in between adds (the
+// function scanner does one per address) stay cheap. Returns false if there's already a symbol at
+// the address, the rebuild decides which one is kept then.
+template <typename T, typename E>
+static bool InsertActiveSymbol(std::vector<T>& symbols, u32 address, const E* entry, u64 size) {
+	auto it = std::lower_bound(symbols.begin(), symbols.end(), address, [](const T& symbol, u32 addr) { return symbol.address < addr; });
+	if (it != symbols.end() && it->address == address)
+		return false;
+
+	u64 maxEnd = static_cast<u64>(address) + size;
+	if (it != symbols.begin())
+		maxEnd = std::max(maxEnd, std::prev(it)->maxEnd);
+
+	it = symbols.insert(it, {address, maxEnd, entry});
+	for (++it; it != symbols.end() && it->maxEnd < maxEnd; ++it)
+		it->maxEnd = maxEnd;
+
+	return true;
+}
+
+template <typename T>
+static const T* FindActiveSymbol(const std::vector<T>& symbols, u32 address) {
+	auto it = std::lower_bound(symbols.begin(), symbols.end(), address, [](const T& symbol, u32 addr) { return symbol.address < addr; });
+	return (it != symbols.end() && it->address == address) ? &*it : nullptr;
+}
+
+template <typename T>
+static const T* FindContainingSymbol(const std::vector<T>& symbols, u32 address) {
+	// Walk back from the closest start until nothing lower can reach the address, so the innermost
+	// symbol is found even when it's nested inside (or follows one nested inside) another one.
+	auto it = std::upper_bound(symbols.begin(), symbols.end(), address, [](u32 addr, const T& symbol) { return addr < symbol.address; });
+	while (it != symbols.begin()) {
+		--it;
+		if (it->maxEnd <= address)
+			break;
+		if (static_cast<u64>(it->address) + it->entry->size > address)
+			return &*it;
+	}
+	return nullptr;
+}
+
 void SymbolMap::SortSymbols() {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
 	AssignFunctionIndices();
@@ -41,6 +99,8 @@ void SymbolMap::Clear() {
 	activeFunctions.clear();
 	activeLabels.clear();
 	activeData.clear();
+	activeLabelNames.clear();
+	activeDirty = false;
 	activeModuleEnds.clear();
 	modules.clear();
 }
@@ -106,9 +166,10 @@ bool SymbolMap::LoadNocashSym(const char *filename) {
 
 SymbolType SymbolMap::GetSymbolType(u32 address) const {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	if (activeFunctions.find(address) != activeFunctions.end())
+	EnsureActiveSymbols();
+	if (FindActiveSymbol(activeFunctions, address))
 		return ST_FUNCTION;
-	if (activeData.find(address) != activeData.end())
+	if (FindActiveSymbol(activeData, address))
 		return ST_DATA;
 	return ST_NONE;
 }
@@ -159,14 +220,18 @@ bool SymbolMap::GetSymbolInfo(SymbolInfo *info, u32 address, SymbolType symmask)
 
 u32 SymbolMap::GetNextSymbolAddress(u32 address, SymbolType symmask) {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	const auto functionEntry = symmask & ST_FUNCTION ? activeFunctions.upper_bound(address) : activeFunctions.end();
-	const auto dataEntry = symmask & ST_DATA ? activeData.upper_bound(address) : activeData.end();
+	EnsureActiveSymbols();
+	const auto upperBound = [address](const auto& symbols) {
+		return std::upper_bound(symbols.begin(), symbols.end(), address, [](u32 addr, const auto& symbol) { return addr < symbol.address; });
+	};
+	const auto functionEntry = symmask & ST_FUNCTION ? upperBound(activeFunctions) : activeFunctions.end();
+	const auto dataEntry = symmask & ST_DATA ? upperBound(activeData) : activeData.end();
 
 	if (functionEntry == activeFunctions.end() && dataEntry == activeData.end())
 		return INVALID_ADDRESS;
 
-	u32 funcAddress = (functionEntry != activeFunctions.end()) ? functionEntry->first : 0xFFFFFFFF;
-	u32 dataAddress = (dataEntry != activeData.end()) ? dataEntry->first : 0xFFFFFFFF;
+	u32 funcAddress = (functionEntry != activeFunctions.end()) ? functionEntry->address : 0xFFFFFFFF;
+	u32 dataAddress = (dataEntry != activeData.end()) ? dataEntry->address : 0xFFFFFFFF;
 
 	if (funcAddress <= dataAddress)
 		return funcAddress;
@@ -196,14 +261,15 @@ std::string SymbolMap::GetDescription(unsigned int address) const {
 }
 
 std::vector<SymbolEntry> SymbolMap::GetAllSymbols(SymbolType symmask) {
+	std::lock_guard<std::recursive_mutex> guard(m_lock);
+	EnsureActiveSymbols();
 	std::vector<SymbolEntry> result;
 
 	if (symmask & ST_FUNCTION) {
-		std::lock_guard<std::recursive_mutex> guard(m_lock);
-		for (auto it = activeFunctions.begin(); it != activeFunctions.end(); it++) {
+		for (const auto& function : activeFunctions) {
 			SymbolEntry entry;
-			entry.address = it->first;
-			entry.size = GetFunctionSize(entry.address);
+			entry.address = function.address;
+			entry.size = function.entry->size;
 			const char* name = GetLabelName(entry.address);
 			if (name != NULL)
 				entry.name = name;
@@ -212,11 +278,10 @@ std::vector<SymbolEntry> SymbolMap::GetAllSymbols(SymbolType symmask) {
 	}
 
 	if (symmask & ST_DATA) {
-		std::lock_guard<std::recursive_mutex> guard(m_lock);
-		for (auto it = activeData.begin(); it != activeData.end(); it++) {
+		for (const auto& data : activeData) {
 			SymbolEntry entry;
-			entry.address = it->first;
-			entry.size = GetDataSize(entry.address);
+			entry.address = data.address;
+			entry.size = data.entry->size;
 			const char* name = GetLabelName(entry.address);
 			if (name != NULL)
 				entry.name = name;
@@ -236,7 +301,8 @@ void SymbolMap::AddModule(const char *name, u32 address, u32 size) {
 			it->start = address;
 			it->size = size;
 			activeModuleEnds.insert(std::make_pair(it->start + it->size, *it));
-			UpdateActiveSymbols();
+			activeDirty = true;
+			AssignFunctionIndices();
 			return;
 		}
 	}
@@ -250,13 +316,15 @@ void SymbolMap::AddModule(const char *name, u32 address, u32 size) {
 
 	modules.push_back(mod);
 	activeModuleEnds.insert(std::make_pair(mod.start + mod.size, mod));
-	UpdateActiveSymbols();
+	activeDirty = true;
+	AssignFunctionIndices();
 }
 
 void SymbolMap::UnloadModule(u32 address, u32 size) {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
 	activeModuleEnds.erase(address + size);
-	UpdateActiveSymbols();
+	activeDirty = true;
+	AssignFunctionIndices();
 }
 
 u32 SymbolMap::GetModuleRelativeAddr(u32 address, int moduleIndex) const {
@@ -346,24 +414,17 @@ void SymbolMap::AddFunction(const char* name, u32 address, u32 size, int moduleI
 			existing->second.start = relAddress;
 			existing->second.module = moduleIndex;
 		}
-
-		// Refresh the active item if it exists.
-		auto active = activeFunctions.find(address);
-		if (active != activeFunctions.end() && active->second.module == moduleIndex) {
-			activeFunctions.erase(active);
-			activeFunctions.insert(std::make_pair(address, existing->second));
-		}
+		activeDirty = true;
 	} else {
 		FunctionEntry func;
 		func.start = relAddress;
 		func.size = size;
 		func.index = (int)functions.size();
 		func.module = moduleIndex;
-		functions[symbolKey] = func;
+		const FunctionEntry* entry = &(functions[symbolKey] = func);
 
-		if (IsModuleActive(moduleIndex)) {
-			activeFunctions.insert(std::make_pair(address, func));
-		}
+		if (moduleIndex > 0 || activeDirty || !InsertActiveSymbol(activeFunctions, address, entry, size))
+			activeDirty = true;
 	}
 
 	AddLabel(name, address, moduleIndex);
@@ -371,51 +432,29 @@ void SymbolMap::AddFunction(const char* name, u32 address, u32 size, int moduleI
 
 u32 SymbolMap::GetFunctionStart(u32 address) const {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto it = activeFunctions.upper_bound(address);
-	if (it == activeFunctions.end()) {
-		// check last element
-		auto rit = activeFunctions.rbegin();
-		if (rit != activeFunctions.rend()) {
-			u32 start = rit->first;
-			u32 size = rit->second.size;
-			if (start <= address && start+size > address)
-				return start;
-		}
-		// otherwise there's no function that contains this address
-		return INVALID_ADDRESS;
-	}
-
-	if (it != activeFunctions.begin()) {
-		it--;
-		u32 start = it->first;
-		u32 size = it->second.size;
-		if (start <= address && start+size > address)
-			return start;
-	}
-
-	return INVALID_ADDRESS;
+	EnsureActiveSymbols();
+	const auto function = FindContainingSymbol(activeFunctions, address);
+	return function ? function->address : INVALID_ADDRESS;
 }
 
 u32 SymbolMap::GetFunctionSize(u32 startAddress) const {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto it = activeFunctions.find(startAddress);
-	if (it == activeFunctions.end())
+	EnsureActiveSymbols();
+	const auto function = FindActiveSymbol(activeFunctions, startAddress);
+	if (!function)
 		return INVALID_ADDRESS;
 
-	return it->second.size;
+	return function->entry->size;
 }
 
 int SymbolMap::GetFunctionNum(u32 address) const {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	u32 start = GetFunctionStart(address);
-	if (start == INVALID_ADDRESS)
-		return INVALID_ADDRESS;
-
-	auto it = activeFunctions.find(start);
-	if (it == activeFunctions.end())
+	EnsureActiveSymbols();
+	const auto function = FindContainingSymbol(activeFunctions, address);
+	if (!function)
 		return INVALID_ADDRESS;
 
-	return it->second.index;
+	return function->entry->index;
 }
 
 void SymbolMap::AssignFunctionIndices() {
@@ -432,57 +471,89 @@ void SymbolMap::AssignFunctionIndices() {
 }
 
 void SymbolMap::UpdateActiveSymbols() {
-	// return;   (slow in debug mode)
+	std::lock_guard<std::recursive_mutex> guard(m_lock);
+	RebuildActiveSymbols();
+	AssignFunctionIndices();
+}
+
+void SymbolMap::EnsureActiveSymbols() const {
+	if (activeDirty)
+		RebuildActiveSymbols();
+}
+
+void SymbolMap::RebuildActiveSymbols() const {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
 	std::map<int, u32> activeModuleIndexes;
 	for (auto it = activeModuleEnds.begin(), end = activeModuleEnds.end(); it != end; ++it) {
 		activeModuleIndexes[it->second.index] = it->second.start;
 	}
 
+	const auto getActiveAddress = [&activeModuleIndexes](int module, u32 relAddress, u32* address) {
+		if (module <= 0) {
+			*address = relAddress;
+			return true;
+		}
+
+		const auto mod = activeModuleIndexes.find(module);
+		if (mod == activeModuleIndexes.end())
+			return false;
+
+		*address = mod->second + relAddress;
+		return true;
+	};
+
 	activeFunctions.clear();
 	activeLabels.clear();
 	activeData.clear();
+	activeLabelNames.clear();
 
+	u32 address;
 	for (auto it = functions.begin(), end = functions.end(); it != end; ++it) {
-		const auto mod = activeModuleIndexes.find(it->second.module);
-		if (it->second.module <= 0) {
-			activeFunctions.insert(std::make_pair(it->second.start, it->second));
-		} else if (mod != activeModuleIndexes.end()) {
-			activeFunctions.insert(std::make_pair(mod->second + it->second.start, it->second));
-		}
+		if (getActiveAddress(it->second.module, it->second.start, &address))
+			activeFunctions.push_back({address, 0, &it->second});
 	}
 
 	for (auto it = labels.begin(), end = labels.end(); it != end; ++it) {
-		const auto mod = activeModuleIndexes.find(it->second.module);
-		if (it->second.module <= 0) {
-			activeLabels.insert(std::make_pair(it->second.addr, it->second));
-		} else if (mod != activeModuleIndexes.end()) {
-			activeLabels.insert(std::make_pair(mod->second + it->second.addr, it->second));
-		}
+		if (getActiveAddress(it->second.module, it->second.addr, &address))
+			activeLabels.push_back({address, 0, &it->second});
 	}
 
 	for (auto it = data.begin(), end = data.end(); it != end; ++it) {
-		const auto mod = activeModuleIndexes.find(it->second.module);
-		if (it->second.module <= 0) {
-			activeData.insert(std::make_pair(it->second.start, it->second));
-		} else if (mod != activeModuleIndexes.end()) {
-			activeData.insert(std::make_pair(mod->second + it->second.start, it->second));
-		}
+		if (getActiveAddress(it->second.module, it->second.start, &address))
+			activeData.push_back({address, 0, &it->second});
 	}
 
-	AssignFunctionIndices();
+	SortActiveSymbols(activeFunctions);
+	SortActiveSymbols(activeLabels);
+	SortActiveSymbols(activeData);
+	AssignMaxEnds(activeFunctions);
+	AssignMaxEnds(activeData);
+
+	// Name lookups return the lowest address with a matching name, so keep the first one.
+	activeLabelNames.reserve(activeLabels.size());
+	for (const auto& label : activeLabels)
+		activeLabelNames.emplace(StringUtil::toLower(label.entry->name), label.address);
+
+	activeDirty = false;
+}
+
+bool SymbolMap::IsEmpty() const {
+	std::lock_guard<std::recursive_mutex> guard(m_lock);
+	EnsureActiveSymbols();
+	return activeFunctions.empty() && activeLabels.empty() && activeData.empty();
 }
 
 bool SymbolMap::SetFunctionSize(u32 startAddress, u32 newSize) {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
+	EnsureActiveSymbols();
 
-	auto funcInfo = activeFunctions.find(startAddress);
-	if (funcInfo != activeFunctions.end()) {
-		auto symbolKey = std::make_pair(funcInfo->second.module, funcInfo->second.start);
+	const auto function = FindActiveSymbol(activeFunctions, startAddress);
+	if (function) {
+		auto symbolKey = std::make_pair(function->entry->module, function->entry->start);
 		auto func = functions.find(symbolKey);
 		if (func != functions.end()) {
 			func->second.size = newSize;
-			UpdateActiveSymbols();
+			activeDirty = true;
 		}
 	}
 
@@ -492,30 +563,28 @@ bool SymbolMap::SetFunctionSize(u32 startAddress, u32 newSize) {
 
 bool SymbolMap::RemoveFunction(u32 startAddress, bool removeName) {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
+	EnsureActiveSymbols();
 
-	auto it = activeFunctions.find(startAddress);
-	if (it == activeFunctions.end())
+	const auto function = FindActiveSymbol(activeFunctions, startAddress);
+	if (!function)
 		return false;
 
-	auto symbolKey = std::make_pair(it->second.module, it->second.start);
+	const auto label = removeName ? FindActiveSymbol(activeLabels, startAddress) : nullptr;
+	auto symbolKey = std::make_pair(function->entry->module, function->entry->start);
 	auto it2 = functions.find(symbolKey);
 	if (it2 != functions.end()) {
 		functions.erase(it2);
 	}
-	activeFunctions.erase(it);
 
-	if (removeName) {
-		auto labelIt = activeLabels.find(startAddress);
-		if (labelIt != activeLabels.end()) {
-			symbolKey = std::make_pair(labelIt->second.module, labelIt->second.addr);
-			auto labelIt2 = labels.find(symbolKey);
-			if (labelIt2 != labels.end()) {
-				labels.erase(labelIt2);
-			}
-			activeLabels.erase(labelIt);
+	if (label) {
+		symbolKey = std::make_pair(label->entry->module, label->entry->addr);
+		auto labelIt2 = labels.find(symbolKey);
+		if (labelIt2 != labels.end()) {
+			labels.erase(labelIt2);
 		}
 	}
 
+	activeDirty = true;
 	return true;
 }
 
@@ -541,13 +610,7 @@ void SymbolMap::AddLabel(const char* name, u32 address, int moduleIndex) {
 		if (existing->second.module != moduleIndex) {
 			existing->second.addr = relAddress;
 			existing->second.module = moduleIndex;
-
-			// Refresh the active item if it exists.
-			auto active = activeLabels.find(address);
-			if (active != activeLabels.end() && active->second.module == moduleIndex) {
-				activeLabels.erase(active);
-				activeLabels.insert(std::make_pair(address, existing->second));
-			}
+			activeDirty = true;
 		}
 	} else {
 		LabelEntry label;
@@ -556,41 +619,45 @@ void SymbolMap::AddLabel(const char* name, u32 address, int moduleIndex) {
 		strncpy(label.name, name, 128);
 		label.name[127] = 0;
 
-		labels[symbolKey] = label;
-		if (IsModuleActive(moduleIndex)) {
-			activeLabels.insert(std::make_pair(address, label));
+		const LabelEntry* entry = &(labels[symbolKey] = label);
+		if (moduleIndex > 0 || activeDirty || !InsertActiveSymbol(activeLabels, address, entry, 0)) {
+			activeDirty = true;
+			return;
 		}
+
+		// Name lookups return the lowest address with a matching name.
+		const auto name_it = activeLabelNames.emplace(StringUtil::toLower(entry->name), address).first;
+		name_it->second = std::min(name_it->second, address);
 	}
 }
 
-void SymbolMap::SetLabelName(const char* name, u32 address, bool updateImmediately) {
+void SymbolMap::SetLabelName(const char* name, u32 address) {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto labelInfo = activeLabels.find(address);
-	if (labelInfo == activeLabels.end()) {
+	EnsureActiveSymbols();
+	const auto labelInfo = FindActiveSymbol(activeLabels, address);
+	if (!labelInfo) {
 		AddLabel(name, address);
 	} else {
-		auto symbolKey = std::make_pair(labelInfo->second.module, labelInfo->second.addr);
+		auto symbolKey = std::make_pair(labelInfo->entry->module, labelInfo->entry->addr);
 		auto label = labels.find(symbolKey);
 		if (label != labels.end()) {
 			strncpy(label->second.name, name, ARRAY_SIZE(label->second.name));
 			label->second.name[ARRAY_SIZE(label->second.name) - 1] = 0;
 
-			// Allow the caller to skip this as it causes extreme startup slowdown
-			// when this gets called for every function identified by the function replacement code.
-			if (updateImmediately) {
-				UpdateActiveSymbols();
-			}
+			// Only the name index needs redoing, but that's rebuilt with everything else.
+			activeDirty = true;
 		}
 	}
 }
 
 const char *SymbolMap::GetLabelName(u32 address) const {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto it = activeLabels.find(address);
-	if (it == activeLabels.end())
+	EnsureActiveSymbols();
+	const auto label = FindActiveSymbol(activeLabels, address);
+	if (!label)
 		return NULL;
 
-	return it->second.name;
+	return label->entry->name;
 }
 
 const char *SymbolMap::GetLabelNameRel(u32 relAddress, int moduleIndex) const {
@@ -612,14 +679,13 @@ std::string SymbolMap::GetLabelString(u32 address) const {
 
 bool SymbolMap::GetLabelValue(const char* name, u32& dest) {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	for (auto it = activeLabels.begin(); it != activeLabels.end(); it++) {
-		if (strcasecmp(name, it->second.name) == 0) {
-			dest = it->first;
-			return true;
-		}
-	}
+	EnsureActiveSymbols();
+	const auto it = activeLabelNames.find(StringUtil::toLower(name));
+	if (it == activeLabelNames.end())
+		return false;
 
-	return false;
+	dest = it->second;
+	return true;
 }
 
 void SymbolMap::AddData(u32 address, u32 size, DataType type, int moduleIndex) {
@@ -645,69 +711,41 @@ void SymbolMap::AddData(u32 address, u32 size, DataType type, int moduleIndex) {
 			existing->second.module = moduleIndex;
 			existing->second.start = relAddress;
 		}
-
-		// Refresh the active item if it exists.
-		auto active = activeData.find(address);
-		if (active != activeData.end() && active->second.module == moduleIndex) {
-			activeData.erase(active);
-			activeData.insert(std::make_pair(address, existing->second));
-		}
+		activeDirty = true;
 	} else {
 		DataEntry entry;
 		entry.start = relAddress;
 		entry.size = size;
 		entry.type = type;
 		entry.module = moduleIndex;
+		const DataEntry* added = &(data[symbolKey] = entry);
 
-		data[symbolKey] = entry;
-		if (IsModuleActive(moduleIndex)) {
-			activeData.insert(std::make_pair(address, entry));
-		}
+		if (moduleIndex > 0 || activeDirty || !InsertActiveSymbol(activeData, address, added, size))
+			activeDirty = true;
 	}
 }
 
 u32 SymbolMap::GetDataStart(u32 address) const {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto it = activeData.upper_bound(address);
-	if (it == activeData.end())
-	{
-		// check last element
-		auto rit = activeData.rbegin();
-
-		if (rit != activeData.rend())
-		{
-			u32 start = rit->first;
-			u32 size = rit->second.size;
-			if (start <= address && start+size > address)
-				return start;
-		}
-		// otherwise there's no data that contains this address
-		return INVALID_ADDRESS;
-	}
-
-	if (it != activeData.begin()) {
-		it--;
-		u32 start = it->first;
-		u32 size = it->second.size;
-		if (start <= address && start+size > address)
-			return start;
-	}
-
-	return INVALID_ADDRESS;
+	EnsureActiveSymbols();
+	const auto data = FindContainingSymbol(activeData, address);
+	return data ? data->address : INVALID_ADDRESS;
 }
 
 u32 SymbolMap::GetDataSize(u32 startAddress) const {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto it = activeData.find(startAddress);
-	if (it == activeData.end())
+	EnsureActiveSymbols();
+	const auto data = FindActiveSymbol(activeData, startAddress);
+	if (!data)
 		return INVALID_ADDRESS;
-	return it->second.size;
+	return data->entry->size;
 }
 
 DataType SymbolMap::GetDataType(u32 startAddress) const {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto it = activeData.find(startAddress);
-	if (it == activeData.end())
+	EnsureActiveSymbols();
+	const auto data = FindActiveSymbol(activeData, startAddress);
+	if (!data)
 		return DATATYPE_NONE;
-	return it->second.type;
+	return data->entry->type;
 }
@@ -20,6 +20,7 @@
 #include <map>
 #include <string>
 #include <mutex>
+#include <unordered_map>
 
 #include "common/Pcsx2Types.h"
 
@@ -84,7 +85,7 @@ public:
 
 	void AddLabel(const char* name, u32 address, int moduleIndex = -1);
 	std::string GetLabelString(u32 address) const;
-	void SetLabelName(const char* name, u32 address, bool updateImmediately = true);
+	void SetLabelName(const char* name, u32 address);
 	bool GetLabelValue(const char* name, u32& dest);
 
 	void AddData(u32 address, u32 size, DataType type, int moduleIndex = -1);
@@ -95,9 +96,11 @@ public:
 	static const u32 INVALID_ADDRESS = (u32)-1;
 
 	void UpdateActiveSymbols();
-	bool IsEmpty() const { return activeFunctions.empty() && activeLabels.empty() && activeData.empty(); };
+	bool IsEmpty() const;
 private:
 	void AssignFunctionIndices();
+	void RebuildActiveSymbols() const;
+	void EnsureActiveSymbols() const;
 	const char *GetLabelName(u32 address) const;
 	const char *GetLabelNameRel(u32 relAddress, int moduleIndex) const;
 
@@ -129,10 +132,23 @@ private:
 		char name[128];
 	};
 
-	// These are flattened, read-only copies of the actual data in active modules only.
-	std::map<u32, const FunctionEntry> activeFunctions;
-	std::map<u32, const LabelEntry> activeLabels;
-	std::map<u32, const DataEntry> activeData;
+	template <typename T>
+	struct ActiveSymbol {
+		u32 address;
+		// Highest end address of this or any lower symbol, so containment lookups know when to stop.
+		u64 maxEnd;
+		const T* entry;
+	};
+
+	// These are flattened views of the symbols in active modules only, sorted by address, with at
+	// most one symbol per address. They point into the maps below. New symbols outside of modules
+	// are inserted in place, anything else changing the maps sets activeDirty, and the views get
+	// rebuilt in one go on the next lookup.
+	mutable std::vector<ActiveSymbol<FunctionEntry>> activeFunctions;
+	mutable std::vector<ActiveSymbol<LabelEntry>> activeLabels;
+	mutable std::vector<ActiveSymbol<DataEntry>> activeData;
+	mutable std::unordered_map<std::string, u32> activeLabelNames;
+	mutable bool activeDirty = false;
 
 	// This is indexed by the end address of the module.
 	std::map<u32, const ModuleEntry> activeModuleEnds;
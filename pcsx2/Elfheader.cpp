@@ -20,6 +20,7 @@
 
 #include "GS.h"			// for sending game crc to mtgs
 #include "Elfheader.h"
+#include "DebugTools/MIPSAnalyst.h"
 #include "DebugTools/SymbolMap.h"
 
 u32 ElfCRC;
@@ -297,11 +298,17 @@ void ElfObject::loadSectionHeaders()
 		eS = (Elf32_Sym*)data.GetPtr(secthead[i_st].sh_offset);
 		Console.WriteLn("found %d symbols", secthead[i_st].sh_size / sizeof(Elf32_Sym));
 
+		// Don't let a scan of the previous ELF add functions after the clear.
+		MIPSAnalyst::CancelFunctionScan();
 		R5900SymbolMap.Clear();
 		for(uint i = 1; i < (secthead[i_st].sh_size / sizeof(Elf32_Sym)); i++) {
 			if ((eS[i].st_value != 0) && (ELF32_ST_TYPE(eS[i].st_info) == 2))
 			{
-				R5900SymbolMap.AddLabel(&SymNames[eS[i].st_name],eS[i].st_value);
+				// Sized functions are imported as such, so lookups within them work without analysis.
+				if (eS[i].st_size != 0)
+					R5900SymbolMap.AddFunction(&SymNames[eS[i].st_name],eS[i].st_value,eS[i].st_size);
+				else
+					R5900SymbolMap.AddLabel(&SymNames[eS[i].st_name],eS[i].st_value);
 			}
 		}
 	}
@@ -17,6 +17,7 @@
 #include "common/Assertions.h"
 #include "common/FileSystem.h"
 #include "common/Path.h"
+#include "common/PerfTrace.h"
 #include "Frontend/CommonHost.h"
 #include "Frontend/FullscreenUI.h"
 #include "Frontend/InputManager.h"
@@ -143,6 +144,35 @@ static void HotkeySaveStateSlot(s32 slot)
 	VMManager::SaveStateToSlot(slot);
 }
 
+static void HotkeyTogglePerformanceTrace()
+{
+	if (!PerfTrace::IsEnabled())
+	{
+		PerfTrace::Start();
+		Host::AddIconOSDMessage("PerformanceTrace", ICON_FA_CHART_BAR, "Performance trace started.", Host::OSD_QUICK_DURATION);
+		return;
+	}
+
+	PerfTrace::Stop();
+
+	const time_t cur_time = time(nullptr);
+	char local_time[16];
+	if (!strftime(local_time, sizeof(local_time), "%Y%m%d%H%M%S", localtime(&cur_time)))
+		local_time[0] = '\0';
+
+	const std::string filename(Path::Combine(EmuFolders::Logs, fmt::format("trace_{}.json", local_time)));
+	if (PerfTrace::Export(filename.c_str()))
+	{
+		Host::AddIconOSDMessage("PerformanceTrace", ICON_FA_CHART_BAR,
+			fmt::format("Performance trace saved to '{}'.", Path::GetFileName(filename)), Host::OSD_INFO_DURATION);
+	}
+	else
+	{
+		Host::AddIconOSDMessage("PerformanceTrace", ICON_FA_CHART_BAR,
+			fmt::format("Failed to save performance trace to '{}'.", Path::GetFileName(filename)), Host::OSD_ERROR_DURATION);
+	}
+}
+
 BEGIN_HOTKEY_LIST(g_common_hotkeys)
 DEFINE_HOTKEY("OpenPauseMenu", "System", "Open Pause Menu", [](s32 pressed) {
 	if (!pressed && VMManager::HasValidVM())
@@ -236,6 +266,10 @@ DEFINE_HOTKEY("InputRecToggleMode", "System", "Toggle Input Recording Mode", [](
 	if (!pressed && VMManager::HasValidVM())
 		g_InputRecording.getControls().toggleRecordMode();
 })
+DEFINE_HOTKEY("TogglePerformanceTrace", "System", "Toggle Performance Trace Capture", [](s32 pressed) {
+	if (!pressed)
+		HotkeyTogglePerformanceTrace();
+})
 
 DEFINE_HOTKEY("PreviousSaveStateSlot", "Save States", "Select Previous Save Slot", [](s32 pressed) {
 	if (!pressed && VMManager::HasValidVM())
@@ -250,6 +250,15 @@ void ImGuiManager::DrawPerformanceOverlay()
 			DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
 		}
 
+		if (GSConfig.OsdShowVIFStats)
+		{
+			text.clear();
+			fmt::format_to(std::back_inserter(text), "VIF: {:.1f}% hit | {:.2f} probes | {:.0f} compiles/s",
+				PerformanceMetrics::GetVIFCacheHitRate(), PerformanceMetrics::GetVIFCacheAverageProbes(),
+				PerformanceMetrics::GetVIFCacheCompileRate());
+			DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+		}
+
 		if (GSConfig.OsdShowIndicators)
 		{
 			const bool is_normal_speed = (EmuConfig.GS.LimitScalar == EmuConfig.Framerate.NominalScalar);
@@ -25,14 +25,20 @@
 #include "common/Path.h"
 #include "common/SettingsInterface.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 #include "common/Timer.h"
+#include "common/boost_spsc_queue.hpp"
 
 #ifdef _WIN32
 #include "common/RedtapeWindows.h"
 #endif
 
 #include "fmt/core.h"
+#include <algorithm>
+#include <condition_variable>
 #include <csignal>
+#include <mutex>
+#include <vector>
 
 // Used on both Windows and Linux.
 #ifdef _WIN32
@@ -134,10 +140,8 @@ static void ConsoleQt_DoSetColor(ConsoleColors color)
 #endif
 }
 
-static void ConsoleQt_DoWrite(const char* fmt)
+static void WriteToSinks(const char* fmt)
 {
-	std::unique_lock lock(s_log_mutex);
-
 #ifdef _WIN32
 	if (s_console_handle != INVALID_HANDLE_VALUE || s_debugger_attached)
 	{
@@ -163,16 +167,16 @@ static void ConsoleQt_DoWrite(const char* fmt)
 	}
 }
 
-static void ConsoleQt_DoWriteLn(const char* fmt)
+// find time since start of process, but save a syscall if we're not writing timestamps
+static float GetMessageTime()
 {
-	std::unique_lock lock(s_log_mutex);
-
-	// find time since start of process, but save a syscall if we're not writing timestamps
-	float message_time =
-		s_log_timestamps ?
-			static_cast<float>(Common::Timer::ConvertValueToSeconds(Common::Timer::GetCurrentValue() - s_log_start_timestamp)) :
-            0.0f;
+	return s_log_timestamps ?
+			   static_cast<float>(Common::Timer::ConvertValueToSeconds(Common::Timer::GetCurrentValue() - s_log_start_timestamp)) :
+               0.0f;
+}
 
+static void WriteLnToSinks(const char* fmt, float message_time)
+{
 	// split newlines up
 	const char* start = fmt;
 	do
@@ -249,6 +253,27 @@ static void ConsoleQt_DoWriteLn(const char* fmt)
 	} while (start);
 }
 
+static void WriteLnToFileLog(const char* line)
+{
+	if (!emuLog)
+		return;
+
+	std::fputs(line, emuLog);
+	std::fputc('\n', emuLog);
+}
+
+static void ConsoleQt_DoWrite(const char* fmt)
+{
+	std::unique_lock lock(s_log_mutex);
+	WriteToSinks(fmt);
+}
+
+static void ConsoleQt_DoWriteLn(const char* fmt)
+{
+	std::unique_lock lock(s_log_mutex);
+	WriteLnToSinks(fmt, GetMessageTime());
+}
+
 static void ConsoleQt_Newline()
 {
 	ConsoleQt_DoWriteLn("");
@@ -264,8 +289,302 @@ static const IConsoleWriter ConsoleWriter_WinQt = {
 	ConsoleQt_SetTitle,
 };
 
+// --------------------------------------------------------------------------------------
+//  Asynchronous logging
+// --------------------------------------------------------------------------------------
+// Writing to the console or file log can take a long time, especially with the verbose trace
+// logs, and it used to happen on whichever thread was logging, usually the EE thread. When
+// async logging is enabled, messages are formatted on the calling thread, pushed into a
+// lock-free queue owned by that thread, and written out by a separate thread instead.
+
+enum class LogRecordType : u8
+{
+	Write,
+	WriteLn,
+	FileOnly,
+};
+
+struct LogRecord
+{
+	u64 sequence;
+	float time;
+	LogRecordType type;
+	ConsoleColors color;
+	std::string text;
+};
+
+static constexpr size_t ASYNC_LOG_QUEUE_SIZE = 1024;
+
+struct AsyncLogQueue
+{
+	ringbuffer_base<LogRecord, ASYNC_LOG_QUEUE_SIZE> records;
+
+	// Set when the owning thread exits, the writer thread frees the queue once it's empty.
+	std::atomic_bool orphaned{false};
+};
+
+struct AsyncLogQueueOwner
+{
+	AsyncLogQueue* queue = nullptr;
+
+	~AsyncLogQueueOwner()
+	{
+		if (queue)
+			queue->orphaned.store(true, std::memory_order_release);
+	}
+};
+
+static bool s_async_logging = false;
+static bool s_async_drop_when_full = false;
+static Threading::Thread s_async_thread;
+static Threading::WorkSema s_async_sema;
+static std::atomic_bool s_async_active{false};
+static std::atomic_bool s_async_quit{false};
+static std::atomic<u64> s_async_sequence{0};
+static std::atomic<u64> s_async_dropped{0};
+static std::mutex s_async_queues_mutex;
+static std::vector<AsyncLogQueue*> s_async_queues;
+
+// Threads with a full queue sleep on this until the writer has drained the queues again.
+static std::mutex s_async_space_mutex;
+static std::condition_variable s_async_space_cv;
+static std::atomic<u32> s_async_space_waiters{0};
+static u64 s_async_drain_count = 0;
+
+static thread_local AsyncLogQueueOwner s_async_thread_queue;
+static thread_local ConsoleColors s_async_thread_color = DefaultConsoleColor;
+
+static void PushLogRecord(LogRecordType type, const char* text)
+{
+	AsyncLogQueue* queue = s_async_thread_queue.queue;
+	if (!queue)
+	{
+		queue = new AsyncLogQueue();
+		s_async_thread_queue.queue = queue;
+
+		std::unique_lock lock(s_async_queues_mutex);
+		s_async_queues.push_back(queue);
+	}
+
+	const LogRecord record = {s_async_sequence.fetch_add(1, std::memory_order_relaxed),
+		(type == LogRecordType::FileOnly) ? 0.0f : GetMessageTime(), type, s_async_thread_color, text};
+	while (!queue->records.push(record))
+	{
+		if (s_async_drop_when_full)
+		{
+			s_async_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		// Wait for the writer to make some room. The drain count is read before waking the writer,
+		// so the drain it does for us can't be missed.
+		s_async_space_waiters.fetch_add(1, std::memory_order_seq_cst);
+		std::unique_lock lock(s_async_space_mutex);
+		const u64 drain_count = s_async_drain_count;
+		lock.unlock();
+
+		s_async_sema.NotifyOfWork();
+
+		lock.lock();
+		s_async_space_cv.wait(lock, [drain_count]() {
+			return s_async_drain_count != drain_count || !s_async_active.load(std::memory_order_acquire);
+		});
+		lock.unlock();
+		s_async_space_waiters.fetch_sub(1, std::memory_order_relaxed);
+
+		if (!s_async_active.load(std::memory_order_acquire))
+			return;
+	}
+
+	s_async_sema.NotifyOfWork();
+}
+
+static void ConsoleAsync_DoWrite(const char* fmt)
+{
+	PushLogRecord(LogRecordType::Write, fmt);
+}
+
+static void ConsoleAsync_DoWriteLn(const char* fmt)
+{
+	PushLogRecord(LogRecordType::WriteLn, fmt);
+}
+
+static void ConsoleAsync_DoSetColor(ConsoleColors color)
+{
+	// Colours are applied by the writer thread, per record.
+	s_async_thread_color = color;
+}
+
+static void ConsoleAsync_Newline()
+{
+	PushLogRecord(LogRecordType::WriteLn, "");
+}
+
+static const IConsoleWriter ConsoleWriter_Async = {
+	ConsoleAsync_DoWrite,
+	ConsoleAsync_DoWriteLn,
+	ConsoleAsync_DoSetColor,
+
+	ConsoleAsync_DoWrite,
+	ConsoleAsync_Newline,
+	ConsoleQt_SetTitle,
+};
+
+static void WriteLogRecords(std::vector<LogRecord>& records)
+{
+	// Each thread's records are already in order, but the batch has to be merged back together.
+	std::sort(records.begin(), records.end(),
+		[](const LogRecord& lhs, const LogRecord& rhs) { return lhs.sequence < rhs.sequence; });
+
+	std::unique_lock lock(s_log_mutex);
+	ConsoleColors current_color = DefaultConsoleColor;
+	for (const LogRecord& record : records)
+	{
+		if (record.type == LogRecordType::FileOnly)
+		{
+			WriteLnToFileLog(record.text.c_str());
+			continue;
+		}
+
+		if (record.color != current_color)
+		{
+			ConsoleQt_DoSetColor(record.color);
+			current_color = record.color;
+		}
+
+		if (record.type == LogRecordType::Write)
+			WriteToSinks(record.text.c_str());
+		else
+			WriteLnToSinks(record.text.c_str(), record.time);
+	}
+
+	if (current_color != DefaultConsoleColor)
+		ConsoleQt_DoSetColor(DefaultConsoleColor);
+
+	static u64 reported_dropped = 0;
+	const u64 dropped = s_async_dropped.load(std::memory_order_relaxed);
+	if (dropped != reported_dropped)
+	{
+		ConsoleQt_DoSetColor(Color_StrongRed);
+		WriteLnToSinks(fmt::format("*** {} log messages were dropped ***", dropped - reported_dropped).c_str(), GetMessageTime());
+		ConsoleQt_DoSetColor(DefaultConsoleColor);
+		reported_dropped = dropped;
+	}
+
+	std::fflush(stdout);
+	if (emuLog)
+		std::fflush(emuLog);
+}
+
+static void DrainAsyncLogQueues(std::vector<LogRecord>& records)
+{
+	records.clear();
+
+	std::unique_lock lock(s_async_queues_mutex);
+	for (auto it = s_async_queues.begin(); it != s_async_queues.end();)
+	{
+		AsyncLogQueue* queue = *it;
+
+		// Check for orphaning first, so nothing pushed before the thread exited gets missed.
+		const bool orphaned = queue->orphaned.load(std::memory_order_acquire);
+		const auto take = [&records](LogRecord& record) { records.push_back(std::move(record)); };
+		while (queue->records.consume_one(take))
+			;
+
+		if (orphaned)
+		{
+			delete queue;
+			it = s_async_queues.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+	lock.unlock();
+
+	if (s_async_space_waiters.load(std::memory_order_seq_cst) > 0)
+	{
+		std::unique_lock space_lock(s_async_space_mutex);
+		s_async_drain_count++;
+		s_async_space_cv.notify_all();
+	}
+
+	if (!records.empty())
+		WriteLogRecords(records);
+}
+
+// Waits for everything queued so far to be written out.
+static void FlushAsyncLogs()
+{
+	if (s_async_active.load(std::memory_order_acquire))
+	{
+		s_async_sema.NotifyOfWork();
+		s_async_sema.WaitForEmpty();
+	}
+}
+
+static void AsyncLogThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("Log Writer");
+
+	std::vector<LogRecord> records;
+	for (;;)
+	{
+		s_async_sema.WaitForWork();
+
+		const bool quit = s_async_quit.load(std::memory_order_acquire);
+		DrainAsyncLogQueues(records);
+		if (quit)
+			break;
+	}
+
+	s_async_sema.Kill();
+}
+
+static void StopAsyncLogging()
+{
+	if (!s_async_thread.Joinable())
+		return;
+
+	s_async_active.store(false, std::memory_order_release);
+	s_async_quit.store(true, std::memory_order_release);
+	s_async_sema.NotifyOfWork();
+	s_async_thread.Join();
+
+	{
+		std::unique_lock lock(s_async_space_mutex);
+		s_async_space_cv.notify_all();
+	}
+}
+
+static void StartAsyncLogging()
+{
+	if (s_async_thread.Joinable())
+		return;
+
+	s_async_quit.store(false, std::memory_order_release);
+	s_async_sema.Reset();
+	s_async_thread.Start(AsyncLogThreadEntryPoint);
+	s_async_active.store(true, std::memory_order_release);
+
+	// Make sure anything still queued makes it out at exit.
+	static bool atexit_registered = false;
+	if (!atexit_registered)
+	{
+		std::atexit([]() {
+			Console_SetActiveHandler(ConsoleWriter_Null);
+			StopAsyncLogging();
+		});
+		atexit_registered = true;
+	}
+}
+
 static void UpdateLoggingSinks(bool system_console, bool file_log)
 {
+	// Anything still queued was meant for the old sinks.
+	FlushAsyncLogs();
+
 #ifdef _WIN32
 	const bool debugger_attached = IsDebuggerPresent();
 	s_debugger_attached = debugger_attached;
@@ -354,6 +673,7 @@ static void UpdateLoggingSinks(bool system_console, bool file_log)
 	{
 		if (emuLog)
 		{
+			std::unique_lock lock(s_log_mutex);
 			std::fclose(emuLog);
 			emuLog = nullptr;
 			emuLogName = {};
@@ -361,10 +681,17 @@ static void UpdateLoggingSinks(bool system_console, bool file_log)
 	}
 
 	// Discard logs completely if there's no sinks.
-	if (debugger_attached || system_console || file_log)
-		Console_SetActiveHandler(ConsoleWriter_WinQt);
+	const bool any_sinks = (debugger_attached || system_console || file_log);
+	if (any_sinks && s_async_logging)
+	{
+		StartAsyncLogging();
+		Console_SetActiveHandler(ConsoleWriter_Async);
+	}
 	else
-		Console_SetActiveHandler(ConsoleWriter_Null);
+	{
+		Console_SetActiveHandler(any_sinks ? ConsoleWriter_WinQt : ConsoleWriter_Null);
+		StopAsyncLogging();
+	}
 }
 
 void CommonHost::SetFileLogPath(std::string path)
@@ -377,12 +704,29 @@ void CommonHost::SetFileLogPath(std::string path)
 	// reopen on change
 	if (emuLog)
 	{
+		FlushAsyncLogs();
+
+		std::unique_lock lock(s_log_mutex);
 		std::fclose(emuLog);
 		if (!emuLogName.empty())
 			emuLog = FileSystem::OpenCFile(emuLogName.c_str(), "wb");
 	}
 }
 
+void CommonHost::WriteTraceLog(const char* line)
+{
+	if (s_async_active.load(std::memory_order_acquire))
+	{
+		PushLogRecord(LogRecordType::FileOnly, line);
+		return;
+	}
+
+	std::unique_lock lock(s_log_mutex);
+	WriteLnToFileLog(line);
+	if (emuLog)
+		std::fflush(emuLog);
+}
+
 void CommonHost::SetBlockSystemConsole(bool block)
 {
 	s_block_system_console = block;
@@ -399,6 +743,8 @@ void CommonHost::UpdateLogging(SettingsInterface& si)
 	const bool file_logging_enabled = si.GetBoolValue("Logging", "EnableFileLogging", false);
 
 	s_log_timestamps = si.GetBoolValue("Logging", "EnableTimestamps", true);
+	s_async_logging = si.GetBoolValue("Logging", "EnableAsyncLogging", false);
+	s_async_drop_when_full = si.GetBoolValue("Logging", "DropMessagesWhenFull", false);
 
 	const bool any_logging_sinks = system_console_enabled || file_logging_enabled;
 	DevConWriterEnabled = any_logging_sinks && (IsDevBuild || si.GetBoolValue("Logging", "EnableVerbose", false));
@@ -421,6 +767,8 @@ void CommonHost::SetDefaultLoggingSettings(SettingsInterface& si)
 	si.SetBoolValue("Logging", "EnableSystemConsole", false);
 	si.SetBoolValue("Logging", "EnableFileLogging", false);
 	si.SetBoolValue("Logging", "EnableTimestamps", true);
+	si.SetBoolValue("Logging", "EnableAsyncLogging", false);
+	si.SetBoolValue("Logging", "DropMessagesWhenFull", false);
 	si.SetBoolValue("Logging", "EnableVerbose", false);
 	si.SetBoolValue("Logging", "EnableEEConsole", false);
 	si.SetBoolValue("Logging", "EnableIOPConsole", false);
@@ -25,6 +25,9 @@ namespace CommonHost
 	/// Prevents the system console from being displayed.
 	void SetBlockSystemConsole(bool block);
 
+	/// Writes a line to the file log only, for the trace logs which are too verbose for the console.
+	void WriteTraceLog(const char* line);
+
 	/// Updates the Console handler based on the current configuration.
 	void UpdateLogging(SettingsInterface& si);
 
@@ -0,0 +1,177 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+
+#include "NullHostDisplay.h"
+#include "imgui.h"
+
+class NullHostDisplayTexture : public HostDisplayTexture
+{
+public:
+	NullHostDisplayTexture(u32 width, u32 height)
+		: m_width(width)
+		, m_height(height)
+	{
+	}
+	~NullHostDisplayTexture() override = default;
+
+	void* GetHandle() const override { return nullptr; }
+	u32 GetWidth() const override { return m_width; }
+	u32 GetHeight() const override { return m_height; }
+
+private:
+	u32 m_width;
+	u32 m_height;
+};
+
+NullHostDisplay::NullHostDisplay() = default;
+
+NullHostDisplay::~NullHostDisplay() = default;
+
+RenderAPI NullHostDisplay::GetRenderAPI() const
+{
+	return RenderAPI::None;
+}
+
+void* NullHostDisplay::GetDevice() const
+{
+	return nullptr;
+}
+
+void* NullHostDisplay::GetContext() const
+{
+	return nullptr;
+}
+
+void* NullHostDisplay::GetSurface() const
+{
+	return nullptr;
+}
+
+bool NullHostDisplay::HasDevice() const
+{
+	return m_has_device;
+}
+
+bool NullHostDisplay::HasSurface() const
+{
+	return false;
+}
+
+bool NullHostDisplay::CreateDevice(const WindowInfo& wi, VsyncMode vsync)
+{
+	m_window_info = wi;
+	m_vsync_mode = vsync;
+	m_has_device = true;
+	return true;
+}
+
+bool NullHostDisplay::SetupDevice()
+{
+	return true;
+}
+
+bool NullHostDisplay::MakeCurrent()
+{
+	return true;
+}
+
+bool NullHostDisplay::DoneCurrent()
+{
+	return true;
+}
+
+bool NullHostDisplay::ChangeWindow(const WindowInfo& new_wi)
+{
+	m_window_info = new_wi;
+	return true;
+}
+
+void NullHostDisplay::ResizeWindow(s32 new_window_width, s32 new_window_height, float new_window_scale)
+{
+	m_window_info.surface_width = static_cast<u32>(new_window_width);
+	m_window_info.surface_height = static_cast<u32>(new_window_height);
+	m_window_info.surface_scale = new_window_scale;
+}
+
+bool NullHostDisplay::SupportsFullscreen() const
+{
+	return false;
+}
+
+bool NullHostDisplay::IsFullscreen()
+{
+	return false;
+}
+
+bool NullHostDisplay::SetFullscreen(bool fullscreen, u32 width, u32 height, float refresh_rate)
+{
+	return false;
+}
+
+HostDisplay::AdapterAndModeList NullHostDisplay::GetAdapterAndModeList()
+{
+	return {};
+}
+
+void NullHostDisplay::DestroySurface()
+{
+	m_window_info = {};
+}
+
+std::string NullHostDisplay::GetDriverInfo() const
+{
+	return "Null device (no rendering)";
+}
+
+std::unique_ptr<HostDisplayTexture> NullHostDisplay::CreateTexture(u32 width, u32 height, const void* data, u32 data_stride, bool dynamic /* = false */)
+{
+	return std::make_unique<NullHostDisplayTexture>(width, height);
+}
+
+void NullHostDisplay::UpdateTexture(HostDisplayTexture* texture, u32 x, u32 y, u32 width, u32 height, const void* texture_data, u32 texture_data_stride)
+{
+}
+
+void NullHostDisplay::SetVSync(VsyncMode mode)
+{
+	m_vsync_mode = mode;
+}
+
+bool NullHostDisplay::BeginPresent(bool frame_skip)
+{
+	// Nothing to present to, behave like a surfaceless display.
+	ImGui::EndFrame();
+	return false;
+}
+
+void NullHostDisplay::EndPresent()
+{
+}
+
+bool NullHostDisplay::CreateImGuiContext()
+{
+	return true;
+}
+
+void NullHostDisplay::DestroyImGuiContext()
+{
+}
+
+bool NullHostDisplay::UpdateImGuiFontTexture()
+{
+	return true;
+}
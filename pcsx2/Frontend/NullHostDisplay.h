@@ -0,0 +1,65 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "HostDisplay.h"
+
+/// Display which never presents anything. Used to run the GS without a GPU, e.g. for benchmarking.
+class NullHostDisplay final : public HostDisplay
+{
+public:
+	NullHostDisplay();
+	~NullHostDisplay();
+
+	RenderAPI GetRenderAPI() const override;
+	void* GetDevice() const override;
+	void* GetContext() const override;
+	void* GetSurface() const override;
+
+	bool HasDevice() const override;
+	bool HasSurface() const override;
+
+	bool CreateDevice(const WindowInfo& wi, VsyncMode vsync) override;
+	bool SetupDevice() override;
+
+	bool MakeCurrent() override;
+	bool DoneCurrent() override;
+
+	bool ChangeWindow(const WindowInfo& new_wi) override;
+	void ResizeWindow(s32 new_window_width, s32 new_window_height, float new_window_scale) override;
+	bool SupportsFullscreen() const override;
+	bool IsFullscreen() override;
+	bool SetFullscreen(bool fullscreen, u32 width, u32 height, float refresh_rate) override;
+	AdapterAndModeList GetAdapterAndModeList() override;
+	void DestroySurface() override;
+	std::string GetDriverInfo() const override;
+
+	std::unique_ptr<HostDisplayTexture> CreateTexture(u32 width, u32 height, const void* data, u32 data_stride, bool dynamic) override;
+	void UpdateTexture(HostDisplayTexture* texture, u32 x, u32 y, u32 width, u32 height, const void* texture_data, u32 texture_data_stride) override;
+
+	void SetVSync(VsyncMode mode) override;
+
+	bool BeginPresent(bool frame_skip) override;
+	void EndPresent() override;
+
+protected:
+	bool CreateImGuiContext() override;
+	void DestroyImGuiContext() override;
+	bool UpdateImGuiFontTexture() override;
+
+private:
+	bool m_has_device = false;
+};
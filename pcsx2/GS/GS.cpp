@@ -25,6 +25,7 @@
 #include "Renderers/HW/GSRendererHW.h"
 #include "Renderers/HW/GSTextureReplacements.h"
 #include "GSLzma.h"
+#include "GSPng.h"
 #include "MultiISA.h"
 
 #include "common/Console.h"
@@ -103,8 +104,9 @@ void GSshutdown()
 	}
 #endif
 
-	// ensure all screenshots have been saved
+	// ensure all screenshots and texture/draw dumps have been saved
 	GSJoinSnapshotThreads();
+	GSPng::ShutdownWorkers();
 }
 
 void GSclose()
@@ -204,6 +206,10 @@ static bool DoGSOpen(GSRendererType renderer, u8* basemem)
 			break;
 #endif
 
+		case RenderAPI::None:
+			g_gs_device = std::make_unique<GSDeviceNull>();
+			break;
+
 		default:
 			Console.Error("Unknown render API %u", static_cast<unsigned>(g_host_display->GetRenderAPI()));
 			return false;
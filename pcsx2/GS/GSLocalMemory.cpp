@@ -529,6 +529,36 @@ void GSLocalMemory::ReadTexture(const GSOffset& off, const GSVector4i& r, u8* ds
 	}
 }
 
+void GSLocalMemory::MarkBlocksWritten(const GSOffset& off, const GSVector4i& r)
+{
+	const u64 generation = ++m_write_generation;
+	off.loopBlocks(r, [this, generation](u32 bn) { m_block_generation[bn] = generation; });
+}
+
+void GSLocalMemory::MarkAllBlocksWritten()
+{
+	const u64 generation = ++m_write_generation;
+	std::fill(std::begin(m_block_generation), std::end(m_block_generation), generation);
+}
+
+bool GSLocalMemory::HasBlocksWrittenSince(const GSOffset& off, const GSVector4i& block_rect, u64 generation) const
+{
+	GSOffset::BNHelper bn = off.bnMulti(block_rect.left, block_rect.top);
+	const int right = block_rect.right >> off.blockShiftX();
+	const int bottom = block_rect.bottom >> off.blockShiftY();
+
+	for (; bn.blkY() < bottom; bn.nextBlockY())
+	{
+		for (; bn.blkX() < right; bn.nextBlockX())
+		{
+			if (m_block_generation[bn.value()] > generation)
+				return true;
+		}
+	}
+
+	return false;
+}
+
 //
 
 #include "Renderers/SW/GSTextureSW.h"
@@ -558,9 +588,9 @@ void GSLocalMemory::SaveBMP(const std::string& fn, u32 bp, u32 bw, u32 psm, int
 	}
 
 #ifdef PCSX2_DEVBUILD
-	GSPng::Save(GSPng::RGB_A_PNG, fn, static_cast<u8*>(bits), w, h, pitch, GSConfig.PNGCompressionLevel, false);
+	GSPng::SaveAsync(GSPng::RGB_A_PNG, fn, static_cast<u8*>(bits), w, h, pitch, GSConfig.PNGCompressionLevel, false);
 #else
-	GSPng::Save(GSPng::RGB_PNG, fn, static_cast<u8*>(bits), w, h, pitch, GSConfig.PNGCompressionLevel, false);
+	GSPng::SaveAsync(GSPng::RGB_PNG, fn, static_cast<u8*>(bits), w, h, pitch, GSConfig.PNGCompressionLevel, false);
 #endif
 
 	_aligned_free(bits);
@@ -487,6 +487,11 @@ public:
 
 	GSClut m_clut;
 
+	/// Incremented on every write to local memory. Each block records the value of its last write,
+	/// so cached texture hashes can be revalidated without rehashing the whole texture.
+	u64 m_write_generation = 0;
+	u64 m_block_generation[MAX_BLOCKS] = {};
+
 public:
 	static constexpr GSSwizzleInfo swizzle32   {swizzleTables32};
 	static constexpr GSSwizzleInfo swizzle32Z  {swizzleTables32Z};
@@ -1119,6 +1124,19 @@ public:
 
 	void ReadTexture(const GSOffset& off, const GSVector4i& r, u8* dst, int dstpitch, const GIFRegTEXA& TEXA);
 
+	// write tracking
+
+	__forceinline u64 GetWriteGeneration() const { return m_write_generation; }
+
+	/// Records a write to every block which overlaps the given rect.
+	void MarkBlocksWritten(const GSOffset& off, const GSVector4i& r);
+
+	/// Records a write to the whole of local memory, e.g. after loading a state.
+	void MarkAllBlocksWritten();
+
+	/// Returns true if any block in the (block aligned) rect was written after the given generation.
+	bool HasBlocksWrittenSince(const GSOffset& off, const GSVector4i& block_rect, u64 generation) const;
+
 	//
 
 	void SaveBMP(const std::string& fn, u32 bp, u32 bw, u32 psm, int w, int h);
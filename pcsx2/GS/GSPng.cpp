@@ -17,6 +17,11 @@
 #include "GSPng.h"
 #include "GSExtra.h"
 #include "common/FileSystem.h"
+#include "common/Threading.h"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <zlib.h>
 #include <png.h>
 
@@ -39,6 +44,9 @@ struct
 
 namespace GSPng
 {
+	static std::mutex s_worker_mutex;
+	static std::vector<std::unique_ptr<Worker>> s_workers;
+	static size_t s_next_worker = 0;
 
 	bool SaveFile(const std::string& file, const Format fmt, const u8* const image,
 		u8* const row, const int width, const int height, const int pitch,
@@ -73,6 +81,12 @@ namespace GSPng
 
 			png_init_io(png_ptr, fp);
 			png_set_compression_level(png_ptr, compression);
+
+			// Adaptive filtering tries every filter on every row, which costs more than the
+			// deflate itself at the fast levels. Sub alone gets most of the size benefit.
+			if (compression <= Z_BEST_SPEED)
+				png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+
 			png_set_IHDR(png_ptr, info_ptr, width, height, channel_bit_depth, type,
 				PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
 			png_write_info(png_ptr, info_ptr);
@@ -82,12 +96,21 @@ namespace GSPng
 			if (rb_swapped && type != PNG_COLOR_TYPE_GRAY)
 				png_set_bgr(png_ptr);
 
-			for (int y = 0; y < height; ++y)
+			if (offset == 0 && bytes_per_pixel_in == bytes_per_pixel_out)
+			{
+				// Rows can be handed to libpng as they are, without repacking.
+				for (int y = 0; y < height; ++y)
+					png_write_row(png_ptr, (png_bytep)(image + y * pitch));
+			}
+			else
 			{
-				for (int x = 0; x < width; ++x)
-					for (int i = 0; i < bytes_per_pixel_out; ++i)
-						row[bytes_per_pixel_out * x + i] = image[y * pitch + bytes_per_pixel_in * x + i + offset];
-				png_write_row(png_ptr, row);
+				for (int y = 0; y < height; ++y)
+				{
+					for (int x = 0; x < width; ++x)
+						for (int i = 0; i < bytes_per_pixel_out; ++i)
+							row[bytes_per_pixel_out * x + i] = image[y * pitch + bytes_per_pixel_in * x + i + offset];
+					png_write_row(png_ptr, row);
+				}
 			}
 			png_write_end(png_ptr, nullptr);
 
@@ -131,8 +154,42 @@ namespace GSPng
 		return SaveFile(filename, fmt, image, row.get(), w, h, pitch, compression);
 	}
 
-	Transaction::Transaction(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression)
-		: m_fmt(fmt), m_file(file), m_w(w), m_h(h), m_pitch(pitch), m_compression(compression)
+	bool SaveAsync(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression, bool rb_swapped)
+	{
+		std::shared_ptr<Transaction> item = std::make_shared<Transaction>(fmt, file, image, w, h, pitch, compression, rb_swapped);
+		if (!item->m_image)
+			return Save(fmt, file, image, w, h, pitch, compression, rb_swapped);
+
+		// Dumps can be queued from more than one thread, and the job queues are single producer.
+		std::unique_lock lock(s_worker_mutex);
+		if (s_workers.empty())
+		{
+			const size_t num_workers = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+			for (size_t i = 0; i < num_workers; i++)
+			{
+				s_workers.push_back(std::make_unique<Worker>(
+					[]() { Threading::SetNameOfCurrentThread("GS PNG Worker"); },
+					[](std::shared_ptr<Transaction>& item) { Process(item); },
+					[]() {}));
+			}
+		}
+
+		s_workers[s_next_worker]->Push(item);
+		s_next_worker = (s_next_worker + 1) % s_workers.size();
+		return true;
+	}
+
+	void ShutdownWorkers()
+	{
+		std::unique_lock lock(s_worker_mutex);
+		for (const std::unique_ptr<Worker>& worker : s_workers)
+			worker->Wait();
+		s_workers.clear();
+		s_next_worker = 0;
+	}
+
+	Transaction::Transaction(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression, bool rb_swapped)
+		: m_fmt(fmt), m_file(file), m_w(w), m_h(h), m_pitch(pitch), m_compression(compression), m_rb_swapped(rb_swapped)
 	{
 		// Note: yes it would be better to use shared pointer
 		m_image = (u8*)_aligned_malloc(pitch * h, 32);
@@ -148,7 +205,9 @@ namespace GSPng
 
 	void Process(std::shared_ptr<Transaction>& item)
 	{
-		Save(item->m_fmt, item->m_file, item->m_image, item->m_w, item->m_h, item->m_pitch, item->m_compression);
+		// Nobody is waiting on the result any more, so this is the only place a failure shows up.
+		if (!Save(item->m_fmt, item->m_file, item->m_image, item->m_w, item->m_h, item->m_pitch, item->m_compression, item->m_rb_swapped))
+			Console.Error("GS: Failed to save image '%s'.", item->m_file.c_str());
 	}
 
 } // namespace GSPng
@@ -42,13 +42,22 @@ namespace GSPng
 		int m_h;
 		int m_pitch;
 		int m_compression;
+		bool m_rb_swapped;
 
-		Transaction(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression);
+		Transaction(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression, bool rb_swapped);
 		~Transaction();
 	};
 
 	bool Save(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression, bool rb_swapped = false);
 
+	/// Copies the image, and encodes/writes it on one of the PNG worker threads.
+	/// Blocks while the workers' queues are full, so dumping can't run away with memory.
+	/// Returns false if the image couldn't be queued or written, failures on the workers are logged.
+	bool SaveAsync(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression, bool rb_swapped = false);
+
+	/// Blocks until every queued image has been written, and stops the worker threads.
+	void ShutdownWorkers();
+
 	void Process(std::shared_ptr<Transaction>& item);
 
 	using Worker = GSJobQueue<std::shared_ptr<Transaction>, 16>;
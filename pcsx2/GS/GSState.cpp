@@ -141,7 +141,10 @@ void GSState::Reset(bool hardware_reset)
 
 	// FIXME: bios logo not shown cut in half after reset, missing graphics in GoW after first FMV
 	if (hardware_reset)
+	{
 		memset(m_mem.m_vm8, 0, m_mem.m_vmsize);
+		m_mem.MarkAllBlocksWritten();
+	}
 	memset(&m_path, 0, sizeof(m_path));
 	memset(&m_v, 0, sizeof(m_v));
 
@@ -2712,6 +2715,7 @@ int GSState::Defrost(const freezeData* fd)
 	ReadState(&m_tr.x, data);
 	ReadState(&m_tr.y, data);
 	ReadState(m_mem.m_vm8, data, m_mem.m_vmsize);
+	m_mem.MarkAllBlocksWritten();
 
 	m_tr.total = 0; // TODO: restore transfer state
 
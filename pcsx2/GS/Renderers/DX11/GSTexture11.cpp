@@ -203,7 +203,7 @@ bool GSTexture11::Save(const std::string& fn)
 		return false;
 	}
 
-	bool success = GSPng::Save(format, fn, static_cast<u8*>(sm.pData), desc.Width, desc.Height, sm.RowPitch, GSConfig.PNGCompressionLevel);
+	bool success = GSPng::SaveAsync(format, fn, static_cast<u8*>(sm.pData), desc.Width, desc.Height, sm.RowPitch, GSConfig.PNGCompressionLevel);
 
 	GSDevice11::GetInstance()->GetD3DContext()->Unmap(res.get(), 0);
 
@@ -19,6 +19,7 @@
 #include "GS/GSGL.h"
 #include "Host.h"
 #include "common/Align.h"
+#include "common/PerfTrace.h"
 #include "common/StringUtil.h"
 
 GSRendererHW::GSRendererHW()
@@ -1231,6 +1232,8 @@ void GSRendererHW::RoundSpriteOffset()
 
 void GSRendererHW::Draw()
 {
+	PERF_TRACE_ZONE("GS", "Draw");
+
 	if (GSConfig.DumpGSData && (s_n >= GSConfig.SaveN))
 	{
 		std::string s;
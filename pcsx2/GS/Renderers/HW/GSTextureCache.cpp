@@ -23,9 +23,21 @@
 #include "GS/GSXXH.h"
 #include "common/Align.h"
 #include "common/HashCombine.h"
+#include "common/PerfTrace.h"
 
 static u8* s_unswizzle_buffer;
 
+// Hashes of single texture levels, keyed by the TEX0 bits which affect the hash (TBP0/TBW/PSM/TW/TH).
+// An entry stays valid until one of the blocks it covers is written to local memory.
+struct LevelHashCacheEntry
+{
+	u64 TEXA;
+	u64 generation;
+	GSTextureCache::HashType hash;
+};
+static std::unordered_map<u64, LevelHashCacheEntry> s_level_hash_cache;
+static constexpr size_t LEVEL_HASH_CACHE_MAX_SIZE = 4096;
+
 GSTextureCache::GSTextureCache()
 {
 	// In theory 4MB is enough but 9MB is safer for overflow (8MB
@@ -81,6 +93,7 @@ void GSTextureCache::RemoveAll()
 
 	m_palette_map.Clear();
 	m_target_heights.clear();
+	s_level_hash_cache.clear();
 
 	m_source_memory_usage = 0;
 	m_target_memory_usage = 0;
@@ -120,6 +133,8 @@ void GSTextureCache::AddDirtyRectTarget(Target* target, GSVector4i rect, u32 psm
 
 GSTextureCache::Source* GSTextureCache::LookupDepthSource(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const GSVector4i& r, bool palette)
 {
+	PERF_TRACE_ZONE("GS", "LookupDepthSource");
+
 	if (GSConfig.UserHacks_DisableDepthSupport)
 	{
 		GL_CACHE("LookupDepthSource not supported (0x%x, F:0x%x)", TEX0.TBP0, TEX0.PSM);
@@ -228,6 +243,8 @@ GSTextureCache::Source* GSTextureCache::LookupDepthSource(const GIFRegTEX0& TEX0
 
 GSTextureCache::Source* GSTextureCache::LookupSource(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const GSVector4i& r, const GSVector2i* lod)
 {
+	PERF_TRACE_ZONE("GS", "LookupSource");
+
 	GL_CACHE("TC: Lookup Source <%d,%d => %d,%d> (0x%x, %s, BW: %u, CBP: 0x%x)", r.x, r.y, r.z, r.w, TEX0.TBP0, psm_str(TEX0.PSM), TEX0.TBW, TEX0.CBP);
 
 	const GSLocalMemory::psm_t& psm_s = GSLocalMemory::m_psm[TEX0.PSM];
@@ -461,6 +478,8 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const GIFRegTEX0& TEX0, con
 
 GSTextureCache::Target* GSTextureCache::LookupTarget(const GIFRegTEX0& TEX0, const GSVector2i& size, int type, bool used, u32 fbmask, const bool is_frame, const int real_w, const int real_h, bool preload)
 {
+	PERF_TRACE_ZONE("GS", "LookupTarget");
+
 	const GSLocalMemory::psm_t& psm_s = GSLocalMemory::m_psm[TEX0.PSM];
 	const GSVector2& new_s = static_cast<GSRendererHW*>(g_gs_renderer.get())->GetTextureScaleFactor();
 	const u32 bp = TEX0.TBP0;
@@ -884,6 +903,8 @@ void GSTextureCache::InvalidateVideoMemType(int type, u32 bp)
 // Called each time you want to write to the GS memory
 void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& rect, bool eewrite, bool target)
 {
+	g_gs_renderer->m_mem.MarkBlocksWritten(off, rect);
+
 	u32 bp = off.bp();
 	u32 bw = off.bw();
 	u32 psm = off.psm();
@@ -2449,6 +2470,7 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 	const GSOffset off = g_gs_renderer->m_mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM);
 	u8* bits = const_cast<u8*>(dltex->get()->GetMapPointer());
 	const u32 pitch = dltex->get()->GetMapPitch();
+	g_gs_renderer->m_mem.MarkBlocksWritten(off, r);
 
 	switch (TEX0.PSM)
 	{
@@ -2488,6 +2510,7 @@ void GSTextureCache::Read(Source* t, const GSVector4i& r)
 	if (m_color_download_texture->Map(drc))
 	{
 		GSOffset off = g_gs_renderer->m_mem.GetOffset(t->m_TEX0.TBP0, t->m_TEX0.TBW, t->m_TEX0.PSM);
+		g_gs_renderer->m_mem.MarkBlocksWritten(off, r);
 		g_gs_renderer->m_mem.WritePixel32(
 			const_cast<u8*>(m_color_download_texture->GetMapPointer()), m_color_download_texture->GetMapPitch(), off, r);
 		m_color_download_texture->Unmap();
@@ -3633,12 +3656,49 @@ static void HashTextureLevel(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, Blo
 	}
 }
 
-GSTextureCache::HashType GSTextureCache::HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
+static GSTextureCache::HashType HashTextureLevelCached(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
 {
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
+	const GSVector4i block_rect(GSVector4i(0, 0, 1 << TEX0.TW, 1 << TEX0.TH).ralign<Align_Outside>(psm.bs));
+	GSLocalMemory& mem = g_gs_renderer->m_mem;
+	const GSOffset off(mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM));
+
+	// TEXA only matters when the texture gets expanded before hashing.
+	const u64 key = TEX0.U64 & 0x00000003FFFFFFFFULL;
+	const u64 texa = (psm.pal == 0 && psm.fmt > 0) ? (TEXA.U64 & 0x000000FF000080FFULL) : 0;
+
+	// Checking the block generations is much cheaper than unswizzling/hashing the texels again.
+	auto it = s_level_hash_cache.find(key);
+	if (it != s_level_hash_cache.end() && it->second.TEXA == texa &&
+		!mem.HasBlocksWrittenSince(off, block_rect, it->second.generation))
+	{
+		return it->second.hash;
+	}
+
 	BlockHashState hash_st;
 	BlockHashReset(hash_st);
 	HashTextureLevel(TEX0, TEXA, hash_st, s_unswizzle_buffer);
-	return FinishBlockHash(hash_st);
+	const GSTextureCache::HashType hash = FinishBlockHash(hash_st);
+
+	const LevelHashCacheEntry entry{texa, mem.GetWriteGeneration(), hash};
+	if (it != s_level_hash_cache.end())
+	{
+		it->second = entry;
+	}
+	else
+	{
+		if (s_level_hash_cache.size() >= LEVEL_HASH_CACHE_MAX_SIZE)
+			s_level_hash_cache.clear();
+
+		s_level_hash_cache.emplace(key, entry);
+	}
+
+	return hash;
+}
+
+GSTextureCache::HashType GSTextureCache::HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
+{
+	return HashTextureLevelCached(TEX0, TEXA);
 }
 
 void GSTextureCache::PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, GSLocalMemory& mem, bool paltex, GSTexture* tex, u32 level)
@@ -3697,22 +3757,26 @@ GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTE
 	ret.TEXA.U64 = (psm.pal == 0 && psm.fmt > 0) ? (TEXA.U64 & 0x000000FF000080FFULL) : 0;
 	ret.CLUTHash = clut ? GSTextureCache::PaletteKeyHash{}({clut, psm.pal}) : 0;
 
+	// single levels can be looked up in the level hash cache
+	if (!lod)
+	{
+		ret.TEX0Hash = HashTextureLevelCached(TEX0, TEXA);
+		return ret;
+	}
+
 	BlockHashState hash_st;
 	BlockHashReset(hash_st);
 
 	// base level is always hashed
 	HashTextureLevel(TEX0, TEXA, hash_st, s_unswizzle_buffer);
 
-	if (lod)
+	// hash and combine full mipmaps when enabled
+	const int basemip = lod->x;
+	const int nmips = lod->y - lod->x + 1;
+	for (int i = 1; i < nmips; i++)
 	{
-		// hash and combine full mipmaps when enabled
-		const int basemip = lod->x;
-		const int nmips = lod->y - lod->x + 1;
-		for (int i = 1; i < nmips; i++)
-		{
-			const GIFRegTEX0 MIP_TEX0{g_gs_renderer->GetTex0Layer(basemip + i)};
-			HashTextureLevel(MIP_TEX0, TEXA, hash_st, s_unswizzle_buffer);
-		}
+		const GIFRegTEX0 MIP_TEX0{g_gs_renderer->GetTex0Layer(basemip + i)};
+		HashTextureLevel(MIP_TEX0, TEXA, hash_st, s_unswizzle_buffer);
 	}
 
 	ret.TEX0Hash = FinishBlockHash(hash_st);
@@ -108,8 +108,12 @@ namespace GSTextureReplacements
 	static TextureName CreateTextureName(const GSTextureCache::HashCacheKey& hash, u32 miplevel);
 	static GSTextureCache::HashCacheKey HashCacheKeyFromTextureName(const TextureName& tn);
 	static std::optional<TextureName> ParseReplacementName(const std::string& filename);
+	static std::optional<TextureName> ParseDumpName(const std::string& filename);
 	static std::string GetGameTextureDirectory();
+	static bool CreateGameTextureDirectory();
+	static std::string GetDumpFileName(const TextureName& name, u32 level);
 	static std::string GetDumpFilename(const TextureName& name, u32 level);
+	static void LoadDumpedTextureList();
 	static std::optional<ReplacementTexture> LoadReplacementTexture(const TextureName& name, const std::string& filename, bool only_base_image);
 	static void QueueAsyncReplacementTextureLoad(const TextureName& name, const std::string& filename, bool mipmap);
 	static void PrecacheReplacementTextures();
@@ -127,9 +131,13 @@ namespace GSTextureReplacements
 	/// Backreference to the texture cache so we can inject replacements.
 	static GSTextureCache* s_tc;
 
-	/// Textures that have been dumped, to save stat() calls.
+	/// Textures that have been dumped, or already existed in the dump directory, to save stat() calls.
+	/// Populated from a single directory listing when dumping starts, so new textures never touch the disk on the GS thread.
 	static std::unordered_set<TextureName> s_dumped_textures;
 
+	/// Whether the dump directory for the current game has been created.
+	static bool s_dump_directory_created = false;
+
 	/// Lookup map of texture names to replacements, if they exist.
 	static std::unordered_map<TextureName, std::string> s_replacement_texture_filenames;
 
@@ -203,16 +211,39 @@ std::optional<TextureName> GSTextureReplacements::ParseReplacementName(const std
 	return ret;
 }
 
+std::optional<TextureName> GSTextureReplacements::ParseDumpName(const std::string& filename)
+{
+	// mip levels get a suffix, which the replacement names don't allow
+	TextureName ret;
+	char extension_dot;
+	if (std::sscanf(filename.c_str(), TEXTURE_FILENAME_CLUT_FORMAT_STRING "-mip%u%c", &ret.TEX0Hash, &ret.CLUTHash, &ret.bits, &ret.miplevel, &extension_dot) == 5 && extension_dot == '.')
+		return ret;
+
+	if (std::sscanf(filename.c_str(), TEXTURE_FILENAME_FORMAT_STRING "-mip%u%c", &ret.TEX0Hash, &ret.bits, &ret.miplevel, &extension_dot) != 4 || extension_dot != '.')
+	{
+		std::optional<TextureName> base(ParseReplacementName(filename));
+		if (!base.has_value())
+			return std::nullopt;
+
+		ret = base.value();
+	}
+
+	// the CLUT format can partially match a name without a palette, and dumps of those never have a CLUT hash
+	if (!ret.HasPalette())
+		ret.CLUTHash = 0;
+
+	return ret;
+}
+
 std::string GSTextureReplacements::GetGameTextureDirectory()
 {
 	return Path::Combine(EmuFolders::Textures, s_current_serial);
 }
 
-std::string GSTextureReplacements::GetDumpFilename(const TextureName& name, u32 level)
+bool GSTextureReplacements::CreateGameTextureDirectory()
 {
-	std::string ret;
-	if (s_current_serial.empty())
-		return ret;
+	if (s_dump_directory_created)
+		return true;
 
 	const std::string game_dir(GetGameTextureDirectory());
 	if (!FileSystem::DirectoryExists(game_dir.c_str()))
@@ -223,29 +254,51 @@ std::string GSTextureReplacements::GetDumpFilename(const TextureName& name, u32
 			!FileSystem::EnsureDirectoryExists(Path::Combine(game_dir, "replacements").c_str(), false))
 		{
 			// if it fails to create, we're not going to be able to use it anyway
-			return ret;
+			return false;
 		}
 	}
 
-	const std::string game_subdir(Path::Combine(game_dir, TEXTURE_DUMP_SUBDIRECTORY_NAME));
+	s_dump_directory_created = true;
+	return true;
+}
 
+std::string GSTextureReplacements::GetDumpFileName(const TextureName& name, u32 level)
+{
 	if (name.HasPalette())
 	{
-		const std::string filename(
-			(level > 0) ?
-                StringUtil::StdStringFromFormat(TEXTURE_FILENAME_CLUT_FORMAT_STRING "-mip%u.png", name.TEX0Hash, name.CLUTHash, name.bits, level) :
-                StringUtil::StdStringFromFormat(TEXTURE_FILENAME_CLUT_FORMAT_STRING ".png", name.TEX0Hash, name.CLUTHash, name.bits));
-		ret = Path::Combine(game_subdir, filename);
+		return (level > 0) ?
+                   StringUtil::StdStringFromFormat(TEXTURE_FILENAME_CLUT_FORMAT_STRING "-mip%u.png", name.TEX0Hash, name.CLUTHash, name.bits, level) :
+                   StringUtil::StdStringFromFormat(TEXTURE_FILENAME_CLUT_FORMAT_STRING ".png", name.TEX0Hash, name.CLUTHash, name.bits);
 	}
 	else
 	{
-		const std::string filename(
-			(level > 0) ?
-                StringUtil::StdStringFromFormat(TEXTURE_FILENAME_FORMAT_STRING "-mip%u.png", name.TEX0Hash, name.bits, level) :
-                StringUtil::StdStringFromFormat(TEXTURE_FILENAME_FORMAT_STRING ".png", name.TEX0Hash, name.bits));
-		ret = Path::Combine(game_subdir, filename);
+		return (level > 0) ?
+                   StringUtil::StdStringFromFormat(TEXTURE_FILENAME_FORMAT_STRING "-mip%u.png", name.TEX0Hash, name.bits, level) :
+                   StringUtil::StdStringFromFormat(TEXTURE_FILENAME_FORMAT_STRING ".png", name.TEX0Hash, name.bits);
 	}
+}
+
+std::string GSTextureReplacements::GetDumpFileName(const GSTextureCache::HashCacheKey& hash, u32 level)
+{
+	return GetDumpFileName(CreateTextureName(hash, level), level);
+}
 
+bool GSTextureReplacements::IsDumpFileNameFor(const std::string& filename, const GSTextureCache::HashCacheKey& hash, u32 level)
+{
+	// same test as the lookup in s_dumped_textures, which also hashes the mip level
+	const std::optional<TextureName> parsed(ParseDumpName(filename));
+	const TextureName name(CreateTextureName(hash, level));
+	return parsed.has_value() && parsed.value() == name && parsed->miplevel == name.miplevel;
+}
+
+std::string GSTextureReplacements::GetDumpFilename(const TextureName& name, u32 level)
+{
+	std::string ret;
+	if (s_current_serial.empty() || !CreateGameTextureDirectory())
+		return ret;
+
+	const std::string game_subdir(Path::Combine(GetGameTextureDirectory(), TEXTURE_DUMP_SUBDIRECTORY_NAME));
+	ret = Path::Combine(game_subdir, GetDumpFileName(name, level));
 	return ret;
 }
 
@@ -258,6 +311,9 @@ void GSTextureReplacements::Initialize(GSTextureCache* tc)
 		StartWorkerThread();
 
 	ReloadReplacementMap();
+
+	if (GSConfig.DumpReplaceableTextures)
+		LoadDumpedTextureList();
 }
 
 void GSTextureReplacements::GameChanged()
@@ -272,6 +328,9 @@ void GSTextureReplacements::GameChanged()
 	s_current_serial = std::move(new_serial);
 	ReloadReplacementMap();
 	ClearDumpedTextureList();
+
+	if (GSConfig.DumpReplaceableTextures)
+		LoadDumpedTextureList();
 }
 
 void GSTextureReplacements::ReloadReplacementMap()
@@ -355,6 +414,8 @@ void GSTextureReplacements::UpdateConfig(Pcsx2Config::GSOptions& old_config)
 
 	if (!GSConfig.DumpReplaceableTextures && old_config.DumpReplaceableTextures)
 		ClearDumpedTextureList();
+	else if (GSConfig.DumpReplaceableTextures && !old_config.DumpReplaceableTextures)
+		LoadDumpedTextureList();
 
 	if (GSConfig.LoadTextureReplacements && GSConfig.PrecacheTextureReplacements && !old_config.PrecacheTextureReplacements)
 		PrecacheReplacementTextures();
@@ -578,9 +639,9 @@ void GSTextureReplacements::DumpTexture(const GSTextureCache::HashCacheKey& hash
 
 	s_dumped_textures.insert(name);
 
-	// already exists on disk?
+	// anything already on disk was picked up by LoadDumpedTextureList(), so no need to check again
 	std::string filename(GetDumpFilename(name, level));
-	if (filename.empty() || FileSystem::FileExists(filename.c_str()))
+	if (filename.empty())
 		return;
 
 	const std::string_view title(Path::GetFileTitle(filename));
@@ -612,6 +673,29 @@ void GSTextureReplacements::DumpTexture(const GSTextureCache::HashCacheKey& hash
 void GSTextureReplacements::ClearDumpedTextureList()
 {
 	s_dumped_textures.clear();
+	s_dump_directory_created = false;
+}
+
+void GSTextureReplacements::LoadDumpedTextureList()
+{
+	// can't dump bios textures.
+	if (s_current_serial.empty())
+		return;
+
+	const std::string dump_dir(Path::Combine(GetGameTextureDirectory(), TEXTURE_DUMP_SUBDIRECTORY_NAME));
+
+	FileSystem::FindResultsArray files;
+	if (!FileSystem::FindFiles(dump_dir.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES, &files))
+		return;
+
+	for (const FILESYSTEM_FIND_DATA& fd : files)
+	{
+		std::optional<TextureName> name = ParseDumpName(std::string(Path::GetFileName(fd.FileName)));
+		if (name.has_value())
+			s_dumped_textures.insert(name.value());
+	}
+
+	DevCon.WriteLn("Found %zu previously dumped textures.", s_dumped_textures.size());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
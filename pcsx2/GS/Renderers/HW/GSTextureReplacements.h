@@ -55,6 +55,12 @@ namespace GSTextureReplacements
 	void DumpTexture(const GSTextureCache::HashCacheKey& hash, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, GSLocalMemory& mem, u32 level);
 	void ClearDumpedTextureList();
 
+	/// File name, without the directory, which a texture's mip level is dumped to.
+	std::string GetDumpFileName(const GSTextureCache::HashCacheKey& hash, u32 level);
+
+	/// Returns true if a file in the dump directory is indexed as the given texture's mip level.
+	bool IsDumpFileNameFor(const std::string& filename, const GSTextureCache::HashCacheKey& hash, u32 level);
+
 	/// Loader will take a filename and interpret the format (e.g. DDS, PNG, etc).
 	using ReplacementTextureLoader = bool (*)(const std::string& filename, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image);
 	ReplacementTextureLoader GetLoader(const std::string_view& filename);
@@ -16,7 +16,46 @@
 #include "PrecompiledHeader.h"
 #include "GSDeviceNull.h"
 
+GSDeviceNull::GSDeviceNull() = default;
+
+GSDeviceNull::~GSDeviceNull() = default;
+
+bool GSDeviceNull::Create()
+{
+	if (!GSDevice::Create())
+		return false;
+
+	// Report what a typical desktop GPU supports, so the HW renderer takes its common paths.
+	m_features.broken_point_sampler = false;
+	m_features.geometry_shader = true;
+	m_features.vs_expand = false;
+	m_features.primitive_id = true;
+	m_features.texture_barrier = true;
+	m_features.provoking_vertex_last = true;
+	m_features.point_expand = false;
+	m_features.line_expand = false;
+	m_features.prefer_new_textures = false;
+	m_features.dxt_textures = true;
+	m_features.bptc_textures = true;
+	m_features.framebuffer_fetch = false;
+	m_features.dual_source_blend = true;
+	m_features.clip_control = true;
+	m_features.stencil_buffer = true;
+	m_features.cas_sharpening = false;
+	return true;
+}
+
 GSTexture* GSDeviceNull::CreateSurface(GSTexture::Type type, int width, int height, int levels, GSTexture::Format format)
 {
 	return new GSTextureNull(type, width, height, levels, format);
 }
+
+std::unique_ptr<GSDownloadTexture> GSDeviceNull::CreateDownloadTexture(u32 width, u32 height, GSTexture::Format format)
+{
+	return std::make_unique<GSDownloadTextureNull>(width, height, format);
+}
+
+void GSDeviceNull::RenderHW(GSHWDrawConfig& config)
+{
+	m_draw_count++;
+}
@@ -18,15 +18,29 @@
 #include "GS/Renderers/Common/GSDevice.h"
 #include "GSTextureNull.h"
 
-class GSDeviceNull : public GSDevice
+/// Device which accepts every draw and texture operation without touching a GPU.
+/// Lets the HW renderer's CPU-side work (texture cache, draw setup) run headless.
+class GSDeviceNull final : public GSDevice
 {
 private:
-	GSTexture* CreateSurface(GSTexture::Type type, int width, int height, int levels, GSTexture::Format format);
+	u64 m_draw_count = 0;
 
-	void DoMerge(GSTexture* sTex[3], GSVector4* sRect, GSTexture* dTex, GSVector4* dRect, const GSRegPMODE& PMODE, const GSRegEXTBUF& EXTBUF, const GSVector4& c) {}
-	void DoInterlace(GSTexture* sTex, GSTexture* dTex, int shader, bool linear, float yoffset = 0, int bufIdx = 0) {}
-	u16 ConvertBlendEnum(u16 generic) { return 0xFFFF; }
+	GSTexture* CreateSurface(GSTexture::Type type, int width, int height, int levels, GSTexture::Format format) override;
+
+	void DoMerge(GSTexture* sTex[3], GSVector4* sRect, GSTexture* dTex, GSVector4* dRect, const GSRegPMODE& PMODE, const GSRegEXTBUF& EXTBUF, const GSVector4& c) override {}
+	void DoInterlace(GSTexture* sTex, GSTexture* dTex, int shader, bool linear, float yoffset, int bufIdx) override {}
+	bool DoCAS(GSTexture* sTex, GSTexture* dTex, bool sharpen_only, const std::array<u32, NUM_CAS_CONSTANTS>& constants) override { return false; }
 
 public:
-	GSDeviceNull() {}
+	GSDeviceNull();
+	~GSDeviceNull() override;
+
+	bool Create() override;
+
+	std::unique_ptr<GSDownloadTexture> CreateDownloadTexture(u32 width, u32 height, GSTexture::Format format) override;
+
+	void RenderHW(GSHWDrawConfig& config) override;
+
+	/// Number of draws submitted through RenderHW() since the device was created.
+	__fi u64 GetDrawCount() const { return m_draw_count; }
 };
@@ -40,3 +40,32 @@ void* GSTextureNull::GetNativeHandle() const
 {
 	return nullptr;
 }
+
+GSDownloadTextureNull::GSDownloadTextureNull(u32 width, u32 height, GSTexture::Format format)
+	: GSDownloadTexture(width, height, format)
+{
+	m_current_pitch = GetTransferPitch(width, 1);
+	m_buffer = std::make_unique<u8[]>(GetBufferSize(width, height, format));
+	std::memset(m_buffer.get(), 0, GetBufferSize(width, height, format));
+}
+
+GSDownloadTextureNull::~GSDownloadTextureNull() = default;
+
+void GSDownloadTextureNull::CopyFromTexture(const GSVector4i& drc, GSTexture* stex, const GSVector4i& src, u32 src_level, bool use_transfer_pitch)
+{
+}
+
+bool GSDownloadTextureNull::Map(const GSVector4i& read_rc)
+{
+	m_map_pointer = m_buffer.get();
+	return true;
+}
+
+void GSDownloadTextureNull::Unmap()
+{
+	m_map_pointer = nullptr;
+}
+
+void GSDownloadTextureNull::Flush()
+{
+}
@@ -40,3 +40,21 @@ public:
 	void Swap(GSTexture* tex) override;
 	void* GetNativeHandle() const override;
 };
+
+/// Readback buffer for the null device. Always reads back zeros.
+class GSDownloadTextureNull final : public GSDownloadTexture
+{
+public:
+	GSDownloadTextureNull(u32 width, u32 height, GSTexture::Format format);
+	~GSDownloadTextureNull() override;
+
+	void CopyFromTexture(const GSVector4i& drc, GSTexture* stex, const GSVector4i& src, u32 src_level, bool use_transfer_pitch) override;
+
+	bool Map(const GSVector4i& read_rc) override;
+	void Unmap() override;
+
+	void Flush() override;
+
+private:
+	std::unique_ptr<u8[]> m_buffer;
+};
@@ -386,7 +386,7 @@ bool GSTextureOGL::Save(const std::string& fn)
 		glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
 	}
 
-	return GSPng::Save(fmt, fn, image.get(), m_size.x, m_size.y, pitch, GSConfig.PNGCompressionLevel);
+	return GSPng::SaveAsync(fmt, fn, image.get(), m_size.x, m_size.y, pitch, GSConfig.PNGCompressionLevel);
 }
 
 void GSTextureOGL::Swap(GSTexture* tex)
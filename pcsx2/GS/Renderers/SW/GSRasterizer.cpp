@@ -1185,6 +1185,11 @@ bool GSSingleRasterizer::IsSynced() const
 	return true;
 }
 
+bool GSSingleRasterizer::WaitForFence(u64 fence)
+{
+	return false;
+}
+
 int GSSingleRasterizer::GetPixels(bool reset /*= true*/)
 {
 	return m_r.GetPixels(reset);
@@ -1262,7 +1267,10 @@ void GSRasterizerList::Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data
 
 	while (top < bottom)
 	{
-		m_workers[m_scanline[top++]]->Push(data);
+		const int i = m_scanline[top++];
+		if (data->fence != 0)
+			m_fences[i].pushed = data->fence;
+		m_workers[i]->Push(data);
 	}
 }
 
@@ -1279,6 +1287,36 @@ void GSRasterizerList::Sync()
 	}
 }
 
+bool GSRasterizerList::WaitForFence(u64 fence)
+{
+	bool waited = false;
+
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		// Workers draw in queue order, so a worker is past the fence once it has finished the fence
+		// or anything after it, or everything it was given. If the draw with the fence wasn't queued
+		// to this worker, we might wait for one extra draw, which is fine.
+		WorkerFence& wf = m_fences[i];
+		const u64 target = std::min(fence, wf.pushed);
+		if (wf.done.load(std::memory_order_acquire) >= target)
+			continue;
+
+		// Workers check for waiters after publishing a fence, so register first, then check again under the lock.
+		waited = true;
+		m_fence_waiters.fetch_add(1, std::memory_order_seq_cst);
+		{
+			std::unique_lock lock(m_fence_mutex);
+			m_fence_cv.wait(lock, [&wf, target]() { return wf.done.load(std::memory_order_seq_cst) >= target; });
+		}
+		m_fence_waiters.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	if (waited)
+		g_perfmon.Put(GSPerfMon::SyncPoint, 1);
+
+	return waited;
+}
+
 bool GSRasterizerList::IsSynced() const
 {
 	for (size_t i = 0; i < m_workers.size(); i++)
@@ -1314,13 +1352,30 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 	}
 
 	std::unique_ptr<GSRasterizerList> rl(new GSRasterizerList(threads));
+	rl->m_fences = std::make_unique<WorkerFence[]>(threads);
 
 	for (int i = 0; i < threads; i++)
 	{
 		rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, i, threads)));
 		auto& r = *rl->m_r[i];
+		auto& wf = rl->m_fences[i];
+		GSRasterizerList* list = rl.get();
 		rl->m_workers.push_back(std::unique_ptr<GSWorker>(new GSWorker([i]() { GSRasterizerList::OnWorkerStartup(i); },
-			[&r](GSRingHeap::SharedPtr<GSRasterizerData>& item) { r.Draw(*item.get()); },
+			[&r, &wf, list](GSRingHeap::SharedPtr<GSRasterizerData>& item) {
+				r.Draw(*item.get());
+				if (item->fence != 0)
+				{
+					wf.done.store(item->fence, std::memory_order_seq_cst);
+					if (list->m_fence_waiters.load(std::memory_order_seq_cst) > 0)
+					{
+						// Taking the lock means the GS thread is either waiting on the cv or hasn't checked yet.
+						{
+							std::unique_lock lock(list->m_fence_mutex);
+						}
+						list->m_fence_cv.notify_all();
+					}
+				}
+			},
 			[i]() { GSRasterizerList::OnWorkerShutdown(i); })));
 	}
 
@@ -44,6 +44,7 @@ public:
 	u64 start;
 	int pixels;
 	int counter;
+	u64 fence; // increases with each queued draw, 0 if the draw doesn't take part in fence waits
 	u8 scanmsk_value;
 
 	GSScanlineGlobalData global;
@@ -64,6 +65,7 @@ public:
 		, frame(0)
 		, start(0)
 		, pixels(0)
+		, fence(0)
 		, scanmsk_value(0)
 	{
 		counter = s_counter++;
@@ -140,6 +142,11 @@ public:
 	virtual void Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data) = 0;
 	virtual void Sync() = 0;
 	virtual bool IsSynced() const = 0;
+
+	/// Waits until every draw queued with a fence up to and including the specified value has finished.
+	/// Returns false if no waiting was needed.
+	virtual bool WaitForFence(u64 fence) = 0;
+
 	virtual int GetPixels(bool reset = true) = 0;
 	virtual void PrintStats() = 0;
 };
@@ -153,6 +160,7 @@ public:
 	void Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data) override;
 	void Sync() override;
 	bool IsSynced() const override;
+	bool WaitForFence(u64 fence) override;
 	int GetPixels(bool reset = true) override;
 	void PrintStats() override;
 
@@ -168,10 +176,20 @@ class GSRasterizerList final : public IRasterizer
 protected:
 	using GSWorker = GSJobQueue<GSRingHeap::SharedPtr<GSRasterizerData>, 65536>;
 
+	struct alignas(64) WorkerFence
+	{
+		u64 pushed = 0; // last fence queued to the worker, only touched by the GS thread
+		std::atomic<u64> done{0}; // last fence the worker finished drawing
+	};
+
 	GSDrawScanline m_ds;
 
-	// Worker threads depend on the rasterizers, so don't change the order.
+	// Worker threads depend on the rasterizers and fences, so don't change the order.
 	std::vector<std::unique_ptr<GSRasterizer>> m_r;
+	std::unique_ptr<WorkerFence[]> m_fences;
+	std::mutex m_fence_mutex;
+	std::condition_variable m_fence_cv;
+	std::atomic<u32> m_fence_waiters{0};
 	std::vector<std::unique_ptr<GSWorker>> m_workers;
 	u8* m_scanline;
 	int m_thread_height;
@@ -191,6 +209,7 @@ public:
 	void Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data) override;
 	void Sync() override;
 	bool IsSynced() const override;
+	bool WaitForFence(u64 fence) override;
 	int GetPixels(bool reset) override;
 	void PrintStats() override;
 };
@@ -36,13 +36,15 @@ GSRendererSW::GSRendererSW(int threads)
 {
 	m_nativeres = true; // ignore ini, sw is always native
 
-	m_tc = std::make_unique<GSTextureCacheSW>();
+	m_tc = std::make_unique<GSTextureCacheSW>(threads);
 	m_rl = GSRasterizerList::Create(threads);
 
 	m_output = (u8*)_aligned_malloc(1024 * 1024 * sizeof(u32), 32);
 
 	std::fill(std::begin(m_fzb_pages), std::end(m_fzb_pages), 0);
 	std::fill(std::begin(m_tex_pages), std::end(m_tex_pages), 0);
+	std::fill(std::begin(m_fzb_page_fences), std::end(m_fzb_page_fences), 0);
+	std::fill(std::begin(m_tex_page_fences), std::end(m_tex_page_fences), 0);
 }
 
 GSRendererSW::~GSRendererSW()
@@ -64,6 +66,8 @@ void GSRendererSW::Reset(bool hardware_reset)
 
 void GSRendererSW::Destroy()
 {
+	PrintSyncStats();
+
 	// Need to destroy worker queue first to stop any pending thread work
 	m_rl.reset();
 	m_tc.reset();
@@ -437,17 +441,21 @@ void GSRendererSW::Draw()
 	if (CheckTargetPages(fb_pages, zb_pages, r))
 	{
 		sd->m_syncpoint = SharedData::SyncTarget;
+		sd->m_sync_fence = GetTargetPagesFence(fb_pages, zb_pages, r);
 	}
 
 	// check if the texture is not part of a target currently in use
 
 	if (CheckSourcePages(sd))
 	{
+		// waiting for the source also covers the target
 		sd->m_syncpoint = SharedData::SyncSource;
+		sd->m_sync_fence = std::max(sd->m_sync_fence, GetSourcePagesFence(sd));
 	}
 
-	// addref source and target pages
+	// addref source and target pages, the fences have to be found before this draw's own pages are marked
 
+	sd->fence = ++m_draw_fence;
 	sd->UsePages(fb_pages, m_context->offset.fb.psm(), zb_pages, m_context->offset.zb.psm());
 
 	//
@@ -549,7 +557,7 @@ void GSRendererSW::Queue(GSRingHeap::SharedPtr<GSRasterizerData>& item)
 
 	if (sd->m_syncpoint == SharedData::SyncSource)
 	{
-		Sync(4);
+		SyncFence(sd->m_sync_fence, 4);
 	}
 
 	// update previously invalidated parts
@@ -558,7 +566,7 @@ void GSRendererSW::Queue(GSRingHeap::SharedPtr<GSRasterizerData>& item)
 
 	if (sd->m_syncpoint == SharedData::SyncTarget)
 	{
-		Sync(5);
+		SyncFence(sd->m_sync_fence, 5);
 	}
 
 	if (LOG)
@@ -596,7 +604,12 @@ void GSRendererSW::Sync(int reason)
 
 	u64 t = LOG ? __rdtsc() : 0;
 
-	m_rl->Sync();
+	if (!m_rl->IsSynced())
+	{
+		const Common::Timer::Value start_time = Common::Timer::GetCurrentValue();
+		m_rl->Sync();
+		RecordSyncStall(reason, true, start_time);
+	}
 
 	if (0) if (LOG)
 	{
@@ -630,6 +643,48 @@ void GSRendererSW::Sync(int reason)
 	g_perfmon.Put(GSPerfMon::Fillrate, pixels);
 }
 
+void GSRendererSW::SyncFence(u64 fence, int reason)
+{
+	if (fence == 0)
+		return;
+
+	const Common::Timer::Value start_time = Common::Timer::GetCurrentValue();
+	if (m_rl->WaitForFence(fence))
+		RecordSyncStall(reason, false, start_time);
+}
+
+void GSRendererSW::RecordSyncStall(int reason, bool full, Common::Timer::Value start_time)
+{
+	if (reason < 0 || reason >= NUM_SYNC_REASONS)
+		return;
+
+	SyncStats& stats = m_sync_stats[reason];
+	if (full)
+		stats.full_syncs++;
+	else
+		stats.fence_waits++;
+	stats.ticks += Common::Timer::GetCurrentValue() - start_time;
+}
+
+void GSRendererSW::PrintSyncStats()
+{
+	// Indexed by the reason passed to Sync()/SyncFence().
+	static constexpr const char* reason_names[NUM_SYNC_REASONS] = {
+		"VSync", "Output", "Pre-draw dump", "Post-draw dump", "Source", "Target", "Write", "Read"};
+
+	for (int reason = 0; reason < NUM_SYNC_REASONS; reason++)
+	{
+		const SyncStats& stats = m_sync_stats[reason];
+		if (stats.full_syncs == 0 && stats.fence_waits == 0)
+			continue;
+
+		DevCon.WriteLn("GS-SW sync %d (%s): %u full, %u fence waits, %.2f ms stalled", reason, reason_names[reason],
+			stats.full_syncs, stats.fence_waits, Common::Timer::ConvertValueToMilliseconds(stats.ticks));
+	}
+
+	m_sync_stats = {};
+}
+
 void  GSRendererSW::ExpandTarget(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r) {}
 
 void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool eewrite)
@@ -647,16 +702,14 @@ void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 
 	if (!m_rl->IsSynced())
 	{
-		pages.loopPagesWithBreak([&](u32 page)
+		u64 fence = 0;
+		pages.loopPages([&](u32 page)
 		{
 			if (m_fzb_pages[page] | m_tex_pages[page])
-			{
-				Sync(6);
-
-				return false;
-			}
-			return true;
+				fence = std::max(fence, std::max(m_fzb_page_fences[page], m_tex_page_fences[page]));
 		});
+
+		SyncFence(fence, 6);
 	}
 
 	m_tc->InvalidatePages(pages, off.psm()); // if texture update runs on a thread and Sync(5) happens then this must come later
@@ -675,16 +728,14 @@ void GSRendererSW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 		GSOffset off = m_mem.GetOffset(BITBLTBUF.SBP, BITBLTBUF.SBW, BITBLTBUF.SPSM);
 		GSOffset::PageLooper pages = off.pageLooperForRect(r);
 
-		pages.loopPagesWithBreak([&](u32 page)
+		u64 fence = 0;
+		pages.loopPages([&](u32 page)
 		{
 			if (m_fzb_pages[page])
-			{
-				Sync(7);
-
-				return false;
-			}
-			return true;
+				fence = std::max(fence, m_fzb_page_fences[page]);
 		});
+
+		SyncFence(fence, 7);
 	}
 }
 
@@ -697,14 +748,17 @@ void GSRendererSW::UsePages(const GSOffset::PageLooper& pages, const int type)
 			case 0:
 				ASSERT((m_fzb_pages[page] & 0xFFFF) < USHRT_MAX);
 				m_fzb_pages[page] += 1;
+				m_fzb_page_fences[page] = m_draw_fence;
 				break;
 			case 1:
 				ASSERT((m_fzb_pages[page] >> 16) < USHRT_MAX);
 				m_fzb_pages[page] += 0x10000;
+				m_fzb_page_fences[page] = m_draw_fence;
 				break;
 			case 2:
 				ASSERT(m_tex_pages[page] < USHRT_MAX);
 				m_tex_pages[page] += 1;
+				m_tex_page_fences[page] = m_draw_fence;
 				break;
 			default:
 				break;
@@ -920,6 +974,33 @@ bool GSRendererSW::CheckTargetPages(const GSOffset::PageLooper* fb_pages, const
 	return res;
 }
 
+u64 GSRendererSW::GetTargetPagesFence(const GSOffset::PageLooper* fb_pages, const GSOffset::PageLooper* zb_pages, const GSVector4i& r) const
+{
+	// CheckTargetPages() looks at both buffers even when one is disabled, so do the same here
+	const GSOffset::PageLooper _fb_pages = fb_pages ? *fb_pages : m_context->offset.fb.pageLooperForRect(r);
+	const GSOffset::PageLooper _zb_pages = zb_pages ? *zb_pages : m_context->offset.zb.pageLooperForRect(r);
+
+	u64 fence = 0;
+	const auto check = [this, &fence](u32 page) {
+		fence = std::max(fence, std::max(m_fzb_page_fences[page], m_tex_page_fences[page]));
+	};
+	_fb_pages.loopPages(check);
+	_zb_pages.loopPages(check);
+	return fence;
+}
+
+u64 GSRendererSW::GetSourcePagesFence(const SharedData* sd) const
+{
+	u64 fence = 0;
+	for (size_t i = 0; sd->m_tex[i].t != NULL; i++)
+	{
+		sd->m_tex[i].t->m_offset.pageLooperForRect(sd->m_tex[i].r).loopPages([this, &fence](u32 page) {
+			fence = std::max(fence, m_fzb_page_fences[page]);
+		});
+	}
+	return fence;
+}
+
 bool GSRendererSW::CheckSourcePages(SharedData* sd)
 {
 	if (!m_rl->IsSynced())
@@ -1445,6 +1526,7 @@ GSRendererSW::SharedData::SharedData()
 	, m_zpsm(0)
 	, m_using_pages(false)
 	, m_syncpoint(SyncNone)
+	, m_sync_fence(0)
 {
 	m_tex[0].t = NULL;
 
@@ -19,6 +19,7 @@
 #include "GS/Renderers/SW/GSRasterizer.h"
 #include "GS/GSRingHeap.h"
 #include "GS/MultiISA.h"
+#include "common/Timer.h"
 
 MULTI_ISA_UNSHARED_START
 
@@ -46,6 +47,7 @@ public:
 			SyncSource,
 			SyncTarget
 		} m_syncpoint;
+		u64 m_sync_fence; // last queued draw which the sync point depends on
 
 	public:
 		SharedData();
@@ -70,6 +72,21 @@ protected:
 	std::atomic<u32> m_fzb_pages[512]; // u16 frame/zbuf pages interleaved
 	std::atomic<u16> m_tex_pages[512];
 
+	// Fence of the last queued draw using each page as a target or texture, so hazards only wait
+	// for the draws which touch the page instead of draining every rasterizer thread.
+	u64 m_fzb_page_fences[512];
+	u64 m_tex_page_fences[512];
+	u64 m_draw_fence = 0;
+
+	struct SyncStats
+	{
+		u32 full_syncs;
+		u32 fence_waits;
+		u64 ticks;
+	};
+	static constexpr int NUM_SYNC_REASONS = 8;
+	std::array<SyncStats, NUM_SYNC_REASONS> m_sync_stats = {};
+
 	void Reset(bool hardware_reset) override;
 	void VSync(u32 field, bool registers_written) override;
 	GSTexture* GetOutput(int i, int& y_offset) override;
@@ -78,6 +95,9 @@ protected:
 	void Draw() override;
 	void Queue(GSRingHeap::SharedPtr<GSRasterizerData>& item);
 	void Sync(int reason);
+	void SyncFence(u64 fence, int reason);
+	void RecordSyncStall(int reason, bool full, Common::Timer::Value start_time);
+	void PrintSyncStats();
 	void ExpandTarget(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r) override;
 	void InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool eewrite = false) override;
 	void InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut = false) override;
@@ -87,6 +107,8 @@ protected:
 
 	bool CheckTargetPages(const GSOffset::PageLooper* fb_pages, const GSOffset::PageLooper* zb_pages, const GSVector4i& r);
 	bool CheckSourcePages(SharedData* sd);
+	u64 GetTargetPagesFence(const GSOffset::PageLooper* fb_pages, const GSOffset::PageLooper* zb_pages, const GSVector4i& r) const;
+	u64 GetSourcePagesFence(const SharedData* sd) const;
 
 	bool GetScanlineGlobalData(SharedData* data);
 
@@ -15,12 +15,62 @@
 
 #include "PrecompiledHeader.h"
 #include "GSTextureCacheSW.h"
+#include "GS/GSThread_CXX11.h"
+#include "common/StringUtil.h"
 
-GSTextureCacheSW::GSTextureCacheSW() = default;
+namespace
+{
+	struct UnswizzleBlock
+	{
+		u32 block;
+		u8* dst;
+	};
+
+	struct UnswizzleJob
+	{
+		const UnswizzleBlock* begin;
+		const UnswizzleBlock* end;
+		GSLocalMemory::readTextureBlock rtxbP;
+		int pitch;
+		GIFRegTEXA TEXA;
+	};
+
+	using UnswizzleWorker = GSJobQueue<UnswizzleJob, 4>;
+} // namespace
+
+// Below this many blocks, waking the helpers costs more than converting on the GS thread.
+static constexpr size_t PARALLEL_UNSWIZZLE_MIN_BLOCKS = 512;
+static constexpr int MAX_UNSWIZZLE_WORKERS = 4;
+
+// Only used from the GS thread, reused between updates to avoid allocating.
+static std::vector<UnswizzleBlock> s_unswizzle_blocks;
+static std::vector<std::unique_ptr<UnswizzleWorker>> s_unswizzle_workers;
+
+static void RunUnswizzleJob(const UnswizzleJob& job)
+{
+	const GSLocalMemory& mem = g_gs_renderer->m_mem;
+	for (const UnswizzleBlock* it = job.begin; it != job.end; ++it)
+		job.rtxbP(mem, it->block, it->dst, job.pitch, job.TEXA);
+}
+
+GSTextureCacheSW::GSTextureCacheSW(int threads)
+{
+	const int num_workers = std::min(threads, MAX_UNSWIZZLE_WORKERS);
+	for (int i = 0; i < num_workers; i++)
+	{
+		s_unswizzle_workers.push_back(std::make_unique<UnswizzleWorker>(
+			[i]() { Threading::SetNameOfCurrentThread(StringUtil::StdStringFromFormat("GS-SW-Unswizzle-%d", i).c_str()); },
+			[](UnswizzleJob& job) { RunUnswizzleJob(job); },
+			[]() {}));
+	}
+}
 
 GSTextureCacheSW::~GSTextureCacheSW()
 {
 	RemoveAll();
+
+	s_unswizzle_workers.clear();
+	std::vector<UnswizzleBlock>().swap(s_unswizzle_blocks);
 }
 
 GSTextureCacheSW::Texture* GSTextureCacheSW::Lookup(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, u32 tw0)
@@ -243,12 +293,8 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 		}
 	}
 
-	GSLocalMemory& mem = g_gs_renderer->m_mem;
-
 	GSOffset off = m_offset;
 
-	u32 blocks = 0;
-
 	GSLocalMemory::readTextureBlock rtxbP = psm.rtxbP;
 
 	u32 pitch = (1 << m_tw) << shift;
@@ -279,9 +325,7 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 				{
 					m_valid[row] |= col;
 
-					rtxbP(mem, block, &dst[bn.blkX() << shift], pitch, m_TEXA);
-
-					blocks++;
+					s_unswizzle_blocks.push_back({block, &dst[bn.blkX() << shift]});
 				}
 			}
 		}
@@ -301,14 +345,40 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 				{
 					m_valid[row] |= col;
 
-					rtxbP(mem, block, &dst[bn.blkX() << shift], pitch, m_TEXA);
-
-					blocks++;
+					s_unswizzle_blocks.push_back({block, &dst[bn.blkX() << shift]});
 				}
 			}
 		}
 	}
 
+	// the blocks are all independent, so large updates (FMVs, full screen copies) can be split up
+	const u32 blocks = static_cast<u32>(s_unswizzle_blocks.size());
+	const UnswizzleBlock* begin = s_unswizzle_blocks.data();
+	const UnswizzleBlock* end = begin + blocks;
+	if (blocks >= PARALLEL_UNSWIZZLE_MIN_BLOCKS && !s_unswizzle_workers.empty())
+	{
+		const size_t num_jobs = s_unswizzle_workers.size() + 1;
+		const size_t blocks_per_job = (blocks + num_jobs - 1) / num_jobs;
+		for (const std::unique_ptr<UnswizzleWorker>& worker : s_unswizzle_workers)
+		{
+			const UnswizzleBlock* job_end = std::min(begin + blocks_per_job, end);
+			worker->Push({begin, job_end, rtxbP, static_cast<int>(pitch), m_TEXA});
+			begin = job_end;
+		}
+
+		// our share is whatever's left over
+		RunUnswizzleJob({begin, end, rtxbP, static_cast<int>(pitch), m_TEXA});
+
+		for (const std::unique_ptr<UnswizzleWorker>& worker : s_unswizzle_workers)
+			worker->Wait();
+	}
+	else if (blocks > 0)
+	{
+		RunUnswizzleJob({begin, end, rtxbP, static_cast<int>(pitch), m_TEXA});
+	}
+
+	s_unswizzle_blocks.clear();
+
 	if (blocks > 0)
 	{
 		g_perfmon.Put(GSPerfMon::Unswizzle, bs.x * bs.y * blocks << shift);
@@ -57,7 +57,8 @@ protected:
 	std::array<FastList<Texture*>, MAX_PAGES> m_map;
 
 public:
-	GSTextureCacheSW();
+	/// threads is the number of helper threads to split large texture updates across, 0 to convert on the calling thread only.
+	GSTextureCacheSW(int threads = 0);
 	virtual ~GSTextureCacheSW();
 
 	Texture* Lookup(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, u32 tw0 = 0);
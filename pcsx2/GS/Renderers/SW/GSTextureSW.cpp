@@ -92,7 +92,7 @@ bool GSTextureSW::Save(const std::string& fn)
 	GSPng::Format fmt = GSPng::RGB_PNG;
 #endif
 	int compression = GSConfig.PNGCompressionLevel;
-	return GSPng::Save(fmt, fn, static_cast<u8*>(m_data), m_size.x, m_size.y, m_pitch, compression);
+	return GSPng::SaveAsync(fmt, fn, static_cast<u8*>(m_data), m_size.x, m_size.y, m_pitch, compression);
 }
 
 void GSTextureSW::Swap(GSTexture* tex)
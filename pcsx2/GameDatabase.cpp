@@ -21,6 +21,7 @@
 #include "vtlb.h"
 
 #include "common/FileSystem.h"
+#include "common/General.h"
 #include "common/Path.h"
 #include "common/StringUtil.h"
 #include "common/Timer.h"
@@ -30,6 +31,7 @@
 #include "ryml.hpp"
 #include "fmt/core.h"
 #include "fmt/ranges.h"
+#include <algorithm>
 #include <fstream>
 #include <mutex>
 #include <optional>
@@ -43,15 +45,53 @@ namespace GameDatabaseSchema
 
 namespace GameDatabase
 {
+	// The cache is a header, an index of the entries sorted by serial, then the YAML text of each
+	// entry. Lookups binary search the index and only parse the entry which was asked for, instead
+	// of parsing and materializing the whole database on startup.
+	struct CacheHeader
+	{
+		u32 signature;
+		u32 version;
+		u64 source_timestamp;
+		u32 num_entries;
+		u32 data_size;
+	};
+
+	struct CacheIndexEntry
+	{
+		u32 serial_offset;
+		u32 serial_length;
+		u32 node_offset;
+		u32 node_length;
+	};
+
 	static void parseAndInsert(const std::string_view& serial, const c4::yml::NodeRef& node);
+	static void setYamlCallbacks();
+	static std::vector<u8> buildCache(const std::string& yaml, u64 source_timestamp);
+	static bool validateCache(const u8* data, size_t size, u64 source_timestamp);
+	static bool loadCache(const std::string& path, u64 source_timestamp);
+	static void unloadCache();
+	static const CacheIndexEntry* findCacheEntry(const std::string_view& serial);
+	static const GameDatabaseSchema::GameEntry* decodeEntry(const std::string& serial, const CacheIndexEntry& entry);
 	static void initDatabase();
 } // namespace GameDatabase
 
 static constexpr char GAMEDB_YAML_FILE_NAME[] = "GameIndex.yaml";
+static constexpr char GAMEDB_CACHE_FILE_NAME[] = "gamedb.cache";
+
+static constexpr u32 GAMEDB_CACHE_SIGNATURE = 0x42444750; // PGDB
+static constexpr u32 GAMEDB_CACHE_VERSION = 1;
 
+// Entries decoded from the cache so far, keyed by lower-case serial.
 static std::unordered_map<std::string, GameDatabaseSchema::GameEntry> s_game_db;
+static std::mutex s_game_db_mutex;
 static std::once_flag s_load_once_flag;
 
+// Points at the mapped cache file, or at s_cache_buffer if the cache couldn't be written out.
+static const u8* s_cache_data = nullptr;
+static size_t s_cache_mapping_size = 0;
+static std::vector<u8> s_cache_buffer;
+
 std::string GameDatabaseSchema::GameEntry::memcardFiltersAsString() const
 {
 	return fmt::to_string(fmt::join(memcardFilters, "/"));
@@ -808,7 +848,7 @@ u32 GameDatabaseSchema::GameEntry::applyGSHardwareFixes(Pcsx2Config::GSOptions&
 	return num_applied_fixes;
 }
 
-void GameDatabase::initDatabase()
+void GameDatabase::setYamlCallbacks()
 {
 	ryml::Callbacks rymlCallbacks = ryml::get_callbacks();
 	rymlCallbacks.m_error = [](const char* msg, size_t msg_len, ryml::Location loc, void*) {
@@ -820,42 +860,235 @@ void GameDatabase::initDatabase()
 		throw std::runtime_error(fmt::format("[YAML] Internal Parsing error: {}",
 			msg));
 	});
-	try
+}
+
+std::vector<u8> GameDatabase::buildCache(const std::string& yaml, u64 source_timestamp)
+{
+	struct Entry
 	{
-		auto buf = Host::ReadResourceFileToString(GAMEDB_YAML_FILE_NAME);
-		if (!buf.has_value())
+		std::string serial;
+		size_t node_start;
+		size_t node_end;
+		bool is_map;
+	};
+
+	// The source is copied to the start of the arena, so key offsets in it are offsets in the yaml.
+	ryml::Tree tree = ryml::parse_in_arena(c4::to_csubstr(yaml));
+	const ryml::csubstr arena = tree.arena();
+	ryml::NodeRef root = tree.rootref();
+
+	std::vector<Entry> entries;
+	for (const ryml::NodeRef& n : root.children())
+	{
+		const ryml::csubstr key = n.key();
+		if (key.str < arena.str || key.str >= arena.str + yaml.size())
+			throw std::runtime_error("Key is outside of the source text");
+
+		size_t node_start = static_cast<size_t>(key.str - arena.str);
+		while (node_start > 0 && yaml[node_start - 1] != '\n')
+			node_start--;
+
+		// Serials must be stored as lower-case, as that is how they are retrieved.
+		if (!entries.empty())
+			entries.back().node_end = node_start;
+		entries.push_back({StringUtil::toLower(std::string(key.str, key.len)), node_start, yaml.size(), n.is_map()});
+	}
+
+	// However, YAML's keys are as expected case-sensitive, so we have to explicitly do our own duplicate checking.
+	// Stable sorting keeps the first of any duplicates in front, which is the one we want.
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.serial < rhs.serial; });
+	size_t num_entries = 0;
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		if (i > 0 && entries[i].serial == entries[i - 1].serial)
 		{
-			Console.Error("[GameDB] Unable to open GameDB file, file does not exist.");
-			return;
+			Console.Error(fmt::format("[GameDB] Duplicate serial '{}' found in GameDB. Skipping, Serials are case-insensitive!", entries[i].serial));
+			continue;
 		}
 
-		ryml::Tree tree = ryml::parse_in_arena(c4::to_csubstr(buf.value()));
-		ryml::NodeRef root = tree.rootref();
+		if (entries[i].is_map)
+			entries[num_entries++] = entries[i];
+	}
+	entries.resize(num_entries);
 
-		for (const ryml::NodeRef& n : root.children())
-		{
-			auto serial = StringUtil::toLower(std::string(n.key().str, n.key().len));
+	size_t data_size = sizeof(CacheHeader) + sizeof(CacheIndexEntry) * entries.size();
+	for (const Entry& e : entries)
+		data_size += e.serial.size() + (e.node_end - e.node_start);
+	if (data_size > std::numeric_limits<u32>::max())
+		throw std::runtime_error("GameDB is too large to cache");
 
-			// Serials and CRCs must be inserted as lower-case, as that is how they are retrieved
-			// this is because the application may pass a lowercase CRC or serial along
-			//
-			// However, YAML's keys are as expected case-sensitive, so we have to explicitly do our own duplicate checking
-			if (s_game_db.count(serial) == 1)
-			{
-				Console.Error(fmt::format("[GameDB] Duplicate serial '{}' found in GameDB. Skipping, Serials are case-insensitive!", serial));
-				continue;
-			}
-			if (n.is_map())
-			{
-				parseAndInsert(serial, n);
-			}
+	std::vector<u8> data(data_size);
+	CacheHeader header = {GAMEDB_CACHE_SIGNATURE, GAMEDB_CACHE_VERSION, source_timestamp, static_cast<u32>(entries.size()), static_cast<u32>(data_size)};
+	std::memcpy(data.data(), &header, sizeof(header));
+
+	u32 pos = static_cast<u32>(sizeof(CacheHeader) + sizeof(CacheIndexEntry) * entries.size());
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		const Entry& e = entries[i];
+		CacheIndexEntry index;
+		index.serial_offset = pos;
+		index.serial_length = static_cast<u32>(e.serial.size());
+		std::memcpy(&data[pos], e.serial.data(), e.serial.size());
+		pos += index.serial_length;
+
+		index.node_offset = pos;
+		index.node_length = static_cast<u32>(e.node_end - e.node_start);
+		std::memcpy(&data[pos], yaml.data() + e.node_start, index.node_length);
+		pos += index.node_length;
+
+		std::memcpy(&data[sizeof(CacheHeader) + sizeof(CacheIndexEntry) * i], &index, sizeof(index));
+	}
+
+	return data;
+}
+
+bool GameDatabase::validateCache(const u8* data, size_t size, u64 source_timestamp)
+{
+	if (size < sizeof(CacheHeader))
+		return false;
+
+	const CacheHeader* header = reinterpret_cast<const CacheHeader*>(data);
+	if (header->signature != GAMEDB_CACHE_SIGNATURE || header->version != GAMEDB_CACHE_VERSION ||
+		header->source_timestamp != source_timestamp || header->data_size != size ||
+		sizeof(CacheHeader) + sizeof(CacheIndexEntry) * static_cast<u64>(header->num_entries) > size)
+	{
+		return false;
+	}
+
+	const CacheIndexEntry* index = reinterpret_cast<const CacheIndexEntry*>(data + sizeof(CacheHeader));
+	for (u32 i = 0; i < header->num_entries; i++)
+	{
+		if (static_cast<u64>(index[i].serial_offset) + index[i].serial_length > size ||
+			static_cast<u64>(index[i].node_offset) + index[i].node_length > size)
+		{
+			return false;
 		}
 	}
+
+	return true;
+}
+
+bool GameDatabase::loadCache(const std::string& path, u64 source_timestamp)
+{
+	auto fp = FileSystem::OpenManagedCFile(path.c_str(), "rb");
+	if (!fp)
+		return false;
+
+	const s64 size = FileSystem::FSize64(fp.get());
+	if (size < static_cast<s64>(sizeof(CacheHeader)))
+		return false;
+
+	void* data = HostSys::MapFile(fp.get(), static_cast<size_t>(size), false);
+	if (!data)
+		return false;
+
+	if (!validateCache(static_cast<const u8*>(data), static_cast<size_t>(size), source_timestamp))
+	{
+		Console.Warning("[GameDB] Ignoring out of date cache '%s'", path.c_str());
+		HostSys::UnmapFile(data, static_cast<size_t>(size));
+		return false;
+	}
+
+	s_cache_data = static_cast<const u8*>(data);
+	s_cache_mapping_size = static_cast<size_t>(size);
+	return true;
+}
+
+void GameDatabase::unloadCache()
+{
+	if (s_cache_mapping_size > 0)
+	{
+		HostSys::UnmapFile(const_cast<u8*>(s_cache_data), s_cache_mapping_size);
+		s_cache_mapping_size = 0;
+	}
+
+	s_cache_data = nullptr;
+	s_cache_buffer = {};
+}
+
+const GameDatabase::CacheIndexEntry* GameDatabase::findCacheEntry(const std::string_view& serial)
+{
+	if (!s_cache_data)
+		return nullptr;
+
+	const CacheHeader* header = reinterpret_cast<const CacheHeader*>(s_cache_data);
+	const CacheIndexEntry* begin = reinterpret_cast<const CacheIndexEntry*>(s_cache_data + sizeof(CacheHeader));
+	const CacheIndexEntry* end = begin + header->num_entries;
+	const auto serialOf = [](const CacheIndexEntry& entry) {
+		return std::string_view(reinterpret_cast<const char*>(s_cache_data) + entry.serial_offset, entry.serial_length);
+	};
+
+	const CacheIndexEntry* it = std::lower_bound(begin, end, serial,
+		[&serialOf](const CacheIndexEntry& entry, const std::string_view& value) { return serialOf(entry) < value; });
+	return (it != end && serialOf(*it) == serial) ? it : nullptr;
+}
+
+const GameDatabaseSchema::GameEntry* GameDatabase::decodeEntry(const std::string& serial, const CacheIndexEntry& entry)
+{
+	try
+	{
+		const ryml::csubstr text(reinterpret_cast<const char*>(s_cache_data) + entry.node_offset, entry.node_length);
+		ryml::Tree tree = ryml::parse_in_arena(text);
+		ryml::NodeRef root = tree.rootref();
+		if (root.is_map() && root.num_children() == 1 && root.first_child().is_map())
+			parseAndInsert(serial, root.first_child());
+	}
+	catch (const std::exception& e)
+	{
+		Console.Error(fmt::format("[GameDB] Error occured when decoding '{}': {}", serial, e.what()));
+	}
+
+	const auto gameEntry = s_game_db.find(serial);
+	return (gameEntry != s_game_db.end()) ? &gameEntry->second : nullptr;
+}
+
+void GameDatabase::initDatabase()
+{
+	const std::optional<std::time_t> timestamp = Host::GetResourceFileTimestamp(GAMEDB_YAML_FILE_NAME);
+	const u64 source_timestamp = static_cast<u64>(timestamp.value_or(0));
+	const std::string cache_path = (timestamp.has_value() && !EmuFolders::Cache.empty()) ?
+		Path::Combine(EmuFolders::Cache, GAMEDB_CACHE_FILE_NAME) : std::string();
+	if (!cache_path.empty() && loadCache(cache_path, source_timestamp))
+		return;
+
+	auto buf = Host::ReadResourceFileToString(GAMEDB_YAML_FILE_NAME);
+	if (!buf.has_value())
+	{
+		Console.Error("[GameDB] Unable to open GameDB file, file does not exist.");
+		return;
+	}
+
+	std::vector<u8> cache;
+	try
+	{
+		cache = buildCache(buf.value(), source_timestamp);
+	}
 	catch (const std::exception& e)
 	{
 		Console.Error(fmt::format("[GameDB] Error occured when initializing GameDB: {}", e.what()));
 	}
-	ryml::reset_callbacks();
+	if (cache.empty())
+		return;
+
+	if (!cache_path.empty())
+	{
+		// Write to a temporary and rename over it. Windows can't replace a file while it's mapped, so
+		// if another instance still has the old one open we fail and keep the cache in memory.
+		unloadCache();
+		const std::string temp_path = cache_path + ".tmp";
+		if (FileSystem::WriteBinaryFile(temp_path.c_str(), cache.data(), cache.size()) &&
+			FileSystem::RenamePath(temp_path.c_str(), cache_path.c_str()) &&
+			loadCache(cache_path, source_timestamp))
+		{
+			return;
+		}
+
+		Console.Warning("[GameDB] Failed to write cache '%s', keeping it in memory.", cache_path.c_str());
+		FileSystem::DeleteFilePath(temp_path.c_str());
+	}
+
+	s_cache_buffer = std::move(cache);
+	s_cache_data = s_cache_buffer.data();
 }
 
 void GameDatabase::ensureLoaded()
@@ -863,8 +1096,11 @@ void GameDatabase::ensureLoaded()
 	std::call_once(s_load_once_flag, []() {
 		Common::Timer timer;
 		Console.WriteLn(fmt::format("[GameDB] Has not been initialized yet, initializing..."));
+		// Entries are decoded on lookup for the rest of the session, so the callbacks are left in place.
+		setYamlCallbacks();
 		initDatabase();
-		Console.WriteLn("[GameDB] %zu games on record (loaded in %.2fms)", s_game_db.size(), timer.GetTimeMilliseconds());
+		Console.WriteLn("[GameDB] %u games on record (loaded in %.2fms)",
+			s_cache_data ? reinterpret_cast<const CacheHeader*>(s_cache_data)->num_entries : 0u, timer.GetTimeMilliseconds());
 	});
 }
 
@@ -878,11 +1114,18 @@ const GameDatabaseSchema::GameEntry* GameDatabase::findGame(const std::string_vi
 		return nullptr;
 
 	Console.WriteLn(fmt::format("[GameDB] Searching for '{}' in GameDB", serialLower));
-	const auto gameEntry = s_game_db.find(serialLower);
-	if (gameEntry != s_game_db.end())
+
+	std::unique_lock lock(s_game_db_mutex);
+	const GameDatabaseSchema::GameEntry* game = nullptr;
+	if (const auto gameEntry = s_game_db.find(serialLower); gameEntry != s_game_db.end())
+		game = &gameEntry->second;
+	else if (const CacheIndexEntry* entry = findCacheEntry(serialLower))
+		game = decodeEntry(serialLower, *entry);
+
+	if (game)
 	{
 		Console.WriteLn(fmt::format("[GameDB] Found '{}' in GameDB", serialLower));
-		return &gameEntry->second;
+		return game;
 	}
 
 	Console.Error(fmt::format("[GameDB] Could not find '{}' in GameDB", serialLower));
@@ -155,6 +155,7 @@ VsyncMode Host::GetEffectiveVSyncMode()
 #include "Frontend/D3D11HostDisplay.h"
 #include "Frontend/D3D12HostDisplay.h"
 #endif
+#include "Frontend/NullHostDisplay.h"
 #include "GS/Renderers/Metal/GSMetalCPPAccessible.h"
 
 std::unique_ptr<HostDisplay> HostDisplay::CreateForAPI(RenderAPI api)
@@ -183,6 +184,9 @@ std::unique_ptr<HostDisplay> HostDisplay::CreateForAPI(RenderAPI api)
 			return std::make_unique<VulkanHostDisplay>();
 #endif
 
+		case RenderAPI::None:
+			return std::make_unique<NullHostDisplay>();
+
 		default:
 			Console.Error("Unknown render API %u", static_cast<unsigned>(api));
 			return {};
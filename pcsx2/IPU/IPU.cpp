@@ -343,6 +343,12 @@ __fi bool ipuWrite32(u32 mem, u32 value)
 		return false;
 
 		ipucase(IPU_CTRL): // IPU_CTRL
+			// Each reset starts a new trace, games reset the IPU before every movie.
+			if (EmuConfig.IpuDumpTraces && tIPU_CTRL(value).RST)
+				IPUTraceStart();
+			if (IPUTraceActive)
+				IPUTraceWrite(IPUTraceEvent::Ctrl, value);
+
 			// CTRL = the first 16 bits of ctrl [0x8000ffff], + value for the next 16 bits,
 			// minus the reserved bits. (18-19; 27-29) [0x47f30000]
 			ipuRegs.ctrl.write(value);
@@ -455,12 +461,10 @@ static void ipuSETTH(u32 val)
 // --------------------------------------------------------------------------------------
 
 // When a command is written, we set some various busy flags and clear some other junk.
-// The actual decoding will be handled by IPUworker.
-__fi void IPUCMD_WRITE(u32 val)
+// Returns false if the command completed inline, otherwise the actual decoding will be
+// handled by IPUworker.
+bool ipuCMDSetup(u32 val)
 {
-	// don't process anything if currently busy
-	//if (ipuRegs.ctrl.BUSY) Console.WriteLn("IPU BUSY!"); // wait for thread
-
 	ipuRegs.ctrl.ECD = 0;
 	ipuRegs.ctrl.SCD = 0;
 	ipu_cmd.clear();
@@ -474,13 +478,13 @@ __fi void IPUCMD_WRITE(u32 val)
 			ipuBCLR(val);
 			hwIntcIrq(INTC_IPU); //DMAC_TO_IPU
 			ipuRegs.ctrl.BUSY = 0;
-			return;
+			return false;
 
 		case SCE_IPU_SETTH:
 			ipuSETTH(val);
 			hwIntcIrq(INTC_IPU);
 			ipuRegs.ctrl.BUSY = 0;
-			return;
+			return false;
 
 		case SCE_IPU_IDEC:
 			g_BP.Advance(val & 0x3F);
@@ -524,6 +528,22 @@ __fi void IPUCMD_WRITE(u32 val)
 	}
 
 	ipuRegs.ctrl.BUSY = 1;
+	return true;
+}
+
+__fi void IPUCMD_WRITE(u32 val)
+{
+	// don't process anything if currently busy
+	//if (ipuRegs.ctrl.BUSY) Console.WriteLn("IPU BUSY!"); // wait for thread
+
+	const bool needs_worker = ipuCMDSetup(val);
+
+	// Logged after the setup so a replay sees any input it consumed beforehand.
+	if (IPUTraceActive)
+		IPUTraceWrite(IPUTraceEvent::Cmd, val);
+
+	if (!needs_worker)
+		return;
 
 	// Have a short delay immitating the time it takes to run IDEC/BDEC, other commands are near instant.
 	// Mana Khemia/Metal Saga start IDEC then change IPU0 expecting there to be a delay before IDEC sends data.
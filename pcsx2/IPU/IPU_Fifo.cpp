@@ -111,6 +111,8 @@ int IPU_Fifo_Input::read(void *value)
 	}
 
 	CopyQWC(value, &data[readpos]);
+	if (IPUTraceActive)
+		IPUTraceWrite(IPUTraceEvent::Input, 0, value);
 
 	readpos = (readpos + 4) & 31;
 	g_BP.IFC--;
@@ -133,6 +135,8 @@ int IPU_Fifo_Output::write(const u32 *value, uint size)
 		while (transsize > 0)
 		{
 			CopyQWC(&data[writepos], value);
+			if (IPUTraceActive)
+				IPUTraceWrite(IPUTraceEvent::Output, 0, value);
 			writepos = (writepos + 4) & 31;
 			value += 4;
 			--transsize;
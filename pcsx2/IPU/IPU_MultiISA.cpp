@@ -33,14 +33,6 @@ static const uint decoder_stride = 16;
 
 #if MULTI_ISA_COMPILE_ONCE
 
-static constexpr std::array<u8, 1024> make_clip_lut()
-{
-	std::array<u8, 1024> lut = {};
-	for (int i = -384; i < 640; i++)
-		lut[i+384] = (i < 0) ? 0 : ((i > 255) ? 255 : i);
-	return lut;
-}
-
 static constexpr mpeg2_scan_pack make_scan_pack()
 {
 	constexpr u8 mpeg2_scan_norm[64] = {
@@ -71,7 +63,6 @@ static constexpr mpeg2_scan_pack make_scan_pack()
 	return pack;
 }
 
-alignas(16) const std::array<u8, 1024> g_idct_clip_lut = make_clip_lut();
 alignas(16) const mpeg2_scan_pack mpeg2_scan = make_scan_pack();
 
 #endif
@@ -340,18 +331,14 @@ __ri static void IDCT_Copy(s16* block, u8* dest, const int stride)
 {
 	IDCT_Block(block);
 
+	// Saturating pack clamps to [0,255] exactly like the old clip table did, without the
+	// per-sample lookups (and without reading out of bounds on corrupt streams).
+	const __m128i zero = _mm_setzero_si128();
 	for (int i = 0; i < 8; i++)
 	{
-		dest[0] = (g_idct_clip_lut.data() + 384)[block[0]];
-		dest[1] = (g_idct_clip_lut.data() + 384)[block[1]];
-		dest[2] = (g_idct_clip_lut.data() + 384)[block[2]];
-		dest[3] = (g_idct_clip_lut.data() + 384)[block[3]];
-		dest[4] = (g_idct_clip_lut.data() + 384)[block[4]];
-		dest[5] = (g_idct_clip_lut.data() + 384)[block[5]];
-		dest[6] = (g_idct_clip_lut.data() + 384)[block[6]];
-		dest[7] = (g_idct_clip_lut.data() + 384)[block[7]];
-
-		std::memset(block, 0, 16);
+		const __m128i row = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(dest), _mm_packus_epi16(row, row));
+		_mm_store_si128(reinterpret_cast<__m128i*>(block), zero);
 
 		dest += stride;
 		block += 8;
@@ -1032,9 +1019,9 @@ __ri static bool mpeg2sliceIDEC()
 						decoder.quantizer_scale = quantizer_scale_code << 1;
 				}
 
+				// All 6 blocks are coded and fully overwrite mb8, and the CSC below writes every
+				// pixel of rgb32, so there's no need to clear either of them per macroblock.
 				decoder.coded_block_pattern = 0x3F;//all 6 blocks
-				memzero_sse_a(mb8);
-				memzero_sse_a(rgb32);
 				[[fallthrough]];
 
 			case 1:
@@ -18,15 +18,26 @@
 #include "IPU/IPU.h"
 #include "IPU/IPUdma.h"
 #include "IPU/IPU_MultiISA.h"
+#include "VMManager.h"
+
+#include "common/FileSystem.h"
+#include "common/Path.h"
+
+#include "fmt/format.h"
 
 IPUStatus IPU1Status;
 bool CommandExecuteQueued;
 
+bool IPUTraceActive = false;
+static std::FILE* s_ipu_trace_file = nullptr;
+
 void ipuDmaReset()
 {
 	IPU1Status.InProgress	= false;
 	IPU1Status.DMAFinished	= true;
 	CommandExecuteQueued	= false;
+
+	IPUTraceStop();
 }
 
 void SaveStateBase::ipuDmaFreeze()
@@ -34,6 +45,69 @@ void SaveStateBase::ipuDmaFreeze()
 	FreezeTag( "IPUdma" );
 	Freeze(IPU1Status);
 	Freeze(CommandExecuteQueued);
+
+	// A trace can't be replayed across a state load, the decoder state no longer matches.
+	if (IsLoading())
+		IPUTraceStop();
+}
+
+void IPUTraceStart()
+{
+	IPUTraceStop();
+
+	const std::string serial(VMManager::GetGameSerial());
+	std::string filename;
+	for (u32 index = 0;; index++)
+	{
+		filename = Path::Combine(EmuFolders::Logs, fmt::format("ipu_{}_{:04}.trace", serial.empty() ? "unknown" : serial, index));
+		if (!FileSystem::FileExists(filename.c_str()))
+			break;
+	}
+
+	s_ipu_trace_file = FileSystem::OpenCFile(filename.c_str(), "wb");
+	if (!s_ipu_trace_file)
+	{
+		Console.Error("Failed to open IPU trace '%s'", filename.c_str());
+		return;
+	}
+
+	// Tables which survive a soft reset, everything else is rebuilt by the traced commands.
+	IPUTraceHeader header = {};
+	header.magic = IPU_TRACE_MAGIC;
+	header.version = IPU_TRACE_VERSION;
+	header.ctrl = ipuRegs.ctrl._u32;
+	std::memcpy(header.thresh, g_ipu_thresh, sizeof(header.thresh));
+	std::memcpy(header.vqclut, g_ipu_vqclut, sizeof(header.vqclut));
+	std::memcpy(header.iq, decoder.iq, sizeof(header.iq));
+	std::memcpy(header.niq, decoder.niq, sizeof(header.niq));
+	std::fwrite(&header, sizeof(header), 1, s_ipu_trace_file);
+
+	IPUTraceActive = true;
+	DevCon.WriteLn("IPU trace started: %s", filename.c_str());
+}
+
+void IPUTraceStop()
+{
+	if (!s_ipu_trace_file)
+		return;
+
+	std::fclose(s_ipu_trace_file);
+	s_ipu_trace_file = nullptr;
+	IPUTraceActive = false;
+}
+
+void IPUTraceWrite(IPUTraceEvent type, u32 value, const void* qword)
+{
+	const IPUTraceRecord record = {type, value};
+	std::fwrite(&record, sizeof(record), 1, s_ipu_trace_file);
+	if (qword)
+		std::fwrite(qword, sizeof(u128), 1, s_ipu_trace_file);
+
+	if (std::ferror(s_ipu_trace_file))
+	{
+		Console.Error("IPU trace write failed, stopping capture.");
+		IPUTraceStop();
+	}
 }
 
 static __fi int IPU1chain() {
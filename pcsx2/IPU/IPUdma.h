@@ -34,3 +34,45 @@ extern void IPU1dma();
 
 extern void ipuDmaReset();
 extern IPUStatus IPU1Status;
+
+// --------------------------------------------------------------------------------------
+//  IPU trace capture
+// --------------------------------------------------------------------------------------
+// When EmuConfig.IpuDumpTraces is set, every IPU soft reset starts a new trace file in the
+// logs folder.  The trace holds the register writes that drive the decoder, every quadword
+// the bitstream reader pulls out of the input FIFO, and every quadword the decoder pushes
+// into the output FIFO, which is enough to replay the decode offline (see tests/ctest/core).
+
+static constexpr u32 IPU_TRACE_MAGIC = 0x54555049; // "IPUT"
+static constexpr u32 IPU_TRACE_VERSION = 1;
+
+enum class IPUTraceEvent : u32
+{
+	Ctrl,   // value = IPU_CTRL write
+	Cmd,    // value = IPU_CMD write
+	Input,  // followed by the quadword read from the input FIFO
+	Output, // followed by the quadword written to the output FIFO
+};
+
+struct IPUTraceHeader
+{
+	u32 magic;
+	u32 version;
+	u32 ctrl;
+	u16 thresh[2];
+	u16 vqclut[16];
+	u8 iq[64];
+	u8 niq[64];
+};
+
+struct IPUTraceRecord
+{
+	IPUTraceEvent type;
+	u32 value;
+};
+
+extern bool IPUTraceActive;
+
+extern void IPUTraceStart();
+extern void IPUTraceStop();
+extern void IPUTraceWrite(IPUTraceEvent type, u32 value, const void* qword = nullptr);
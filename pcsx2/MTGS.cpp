@@ -18,6 +18,7 @@
 
 #include <list>
 
+#include "common/PerfTrace.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
 
@@ -315,6 +316,8 @@ void SysMtgsThread::MainLoop()
 		// ever be modified by this thread.
 		while (m_ReadPos.load(std::memory_order_relaxed) != m_WritePos.load(std::memory_order_acquire))
 		{
+			PERF_TRACE_ZONE("MTGS", "Packet");
+
 			const unsigned int local_ReadPos = m_ReadPos.load(std::memory_order_relaxed);
 
 			pxAssert(local_ReadPos < RingBufferSize);
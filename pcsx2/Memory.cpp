@@ -960,6 +960,45 @@ void mmap_MarkCountedRamPage( u32 paddr )
 	vtlb_UpdateFastmemProtection(rampage << __pageshift, __pagesize, PageAccess_ReadOnly());
 }
 
+// Temporarily lifts (or restores) the write protection of a counted page, without changing its
+// protection mode. Lets the patch engine modify code and clear only the blocks it touched, instead
+// of faulting and dropping the whole page to manual protection.
+void mmap_SetCountedRamPageWritable( u32 paddr, bool writable )
+{
+	pxAssert( eeMem );
+
+	uptr ptr = (uptr)PSM( paddr & ~__pagemask );
+	uptr rampage = ptr - (uptr)eeMem->Main;
+
+	if (!ptr || rampage >= Ps2MemSize::MainRam)
+		return;
+
+	rampage >>= __pageshift;
+
+	if( m_PageProtectInfo[rampage].Mode != ProtMode_Write )
+		return;
+
+	HostSys::MemProtect( &eeMem->Main[rampage<<__pageshift], __pagesize, writable ? PageAccess_ReadWrite() : PageAccess_ReadOnly() );
+}
+
+// Clears the recompiled blocks covering words written to a counted page while it was unlocked.
+// The write may have gone through any alias of the page (kseg0, uncached, ...), so the blocks are
+// looked up by the address the page was recompiled from, like mmap_ClearCpuBlock() does.
+void mmap_ClearCountedRamWords( u32 paddr, u32 words )
+{
+	pxAssert( eeMem );
+
+	uptr ptr = (uptr)PSM( paddr & ~__pagemask );
+	uptr rampage = ptr - (uptr)eeMem->Main;
+
+	if (!ptr || rampage >= Ps2MemSize::MainRam)
+		return;
+
+	rampage >>= __pageshift;
+
+	Cpu->Clear( m_PageProtectInfo[rampage].ReverseRamMap + (paddr & __pagemask), words );
+}
+
 // offset - offset of address relative to psM.
 // All recompiled blocks belonging to the page are cleared, and any new blocks recompiled
 // from code residing in this page will use manual protection.
@@ -990,9 +1029,10 @@ void mmap_PageFaultHandler::OnPageFaultEvent( const PageFaultInfo& info, bool& h
 		// this was inside the fastmem area. check if it's a code page
 		// fprintf(stderr, "Fault on fastmem %p vaddr %08X\n", info.addr, vaddr);
 
+		// watched pages aren't mapped at all, those accesses always get backpatched to slowmem
 		uptr ptr = (uptr)PSM(vaddr);
 		uptr offset = (ptr - (uptr)eeMem->Main);
-		if (ptr && m_PageProtectInfo[offset >> __pageshift].Mode == ProtMode_Write)
+		if (ptr && m_PageProtectInfo[offset >> __pageshift].Mode == ProtMode_Write && !vtlb_IsWatchedAddress(vaddr))
 		{
 			// fprintf(stderr, "Not backpatching code write at %08X\n", vaddr);
 			mmap_ClearCpuBlock(offset);
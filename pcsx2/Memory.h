@@ -117,6 +117,8 @@ enum vtlb_ProtectionMode
 
 extern vtlb_ProtectionMode mmap_GetRamPageInfo( u32 paddr );
 extern void mmap_MarkCountedRamPage( u32 paddr );
+extern void mmap_SetCountedRamPageWritable( u32 paddr, bool writable );
+extern void mmap_ClearCountedRamWords( u32 paddr, u32 words );
 extern void mmap_ResetBlockTracking();
 
 #define memRead8 vtlb_memRead<mem8_t>
@@ -34,6 +34,7 @@
 
 #include "fmt/core.h"
 
+#include <limits>
 #include <map>
 
 static const int MCD_SIZE = 1024 * 8 * 16; // Legacy PSX card default size
@@ -163,11 +164,20 @@ static bool ConvertRAWtoNoECC(const char* file_in, const char* file_out)
 // --------------------------------------------------------------------------------------
 // Provides thread-safe direct file IO mapping.
 //
+// Card images are memory mapped where possible, so page accesses are plain copies. Writes
+// are tracked as a dirty range and handed to the OS for writeback once per frame. If the
+// mapping can't be created, we fall back to regular stdio reads and writes.
+//
 class FileMemoryCard
 {
 protected:
 	std::FILE* m_file[8];
 	std::string m_filenames[8];
+	u8* m_mapping[8] = {};
+	u32 m_mapsize[8] = {};
+	u32 m_offset[8] = {};
+	u32 m_dirtystart[8] = {};
+	u32 m_dirtyend[8] = {};
 	u8 m_effeffs[528 * 16];
 	SafeArray<u8> m_currentdata;
 	u64 m_chksum[8];
@@ -191,9 +201,14 @@ public:
 	s32 Save(uint slot, const u8* src, u32 adr, int size);
 	s32 EraseBlock(uint slot, u32 adr);
 	u64 GetCRC(uint slot);
+	void NextFrame(uint slot);
 
 protected:
+	static u32 GetDataOffset(s64 size);
 	bool Seek(std::FILE* f, u32 adr);
+	bool ReadData(uint slot, void* dest, u32 adr, u32 size);
+	bool WriteData(uint slot, const void* src, u32 adr, u32 size);
+	void FlushDirtyRange(uint slot);
 	bool Create(const char* mcdFile, uint sizeInMB);
 };
 
@@ -368,6 +383,21 @@ void FileMemoryCard::Open()
 				if (read_result == 0)
 					Host::ReportFormattedErrorAsync("Memory Card", "Error reading memcard.\n");
 			}
+
+			const s64 size = FileSystem::FSize64(m_file[slot]);
+			if (size > 0 && size <= std::numeric_limits<u32>::max())
+			{
+				m_mapping[slot] = static_cast<u8*>(HostSys::MapFile(m_file[slot], static_cast<size_t>(size)));
+				if (m_mapping[slot])
+				{
+					m_mapsize[slot] = static_cast<u32>(size);
+					m_offset[slot] = GetDataOffset(size);
+				}
+				else
+				{
+					Console.Warning("(FileMcd) Failed to map memory card %u, falling back to file IO.", slot);
+				}
+			}
 		}
 	}
 }
@@ -379,9 +409,25 @@ void FileMemoryCard::Close()
 		if (!m_file[slot])
 			continue;
 
-		// Store checksum
-		if (!m_ispsx[slot] && FileSystem::FSeek64(m_file[slot], m_chkaddr, SEEK_SET) == 0)
+		if (m_mapping[slot])
+		{
+			// Store checksum
+			if (!m_ispsx[slot] && (m_chkaddr + sizeof(m_chksum[slot])) <= m_mapsize[slot])
+				std::memcpy(m_mapping[slot] + m_chkaddr, &m_chksum[slot], sizeof(m_chksum[slot]));
+
+			HostSys::FlushMappedFile(m_mapping[slot], m_mapsize[slot]);
+			HostSys::UnmapFile(m_mapping[slot], m_mapsize[slot]);
+			m_mapping[slot] = nullptr;
+			m_mapsize[slot] = 0;
+			m_offset[slot] = 0;
+			m_dirtystart[slot] = 0;
+			m_dirtyend[slot] = 0;
+		}
+		else if (!m_ispsx[slot] && FileSystem::FSeek64(m_file[slot], m_chkaddr, SEEK_SET) == 0)
+		{
+			// Store checksum
 			std::fwrite(&m_chksum[slot], sizeof(m_chksum[slot]), 1, m_file[slot]);
+		}
 
 		std::fclose(m_file[slot]);
 		m_file[slot] = nullptr;
@@ -397,11 +443,8 @@ void FileMemoryCard::Close()
 	}
 }
 
-// Returns FALSE if the seek failed (is outside the bounds of the file).
-bool FileMemoryCard::Seek(std::FILE* f, u32 adr)
+u32 FileMemoryCard::GetDataOffset(s64 size)
 {
-	const s64 size = FileSystem::FSize64(f);
-
 	// If anyone knows why this filesize logic is here (it appears to be related to legacy PSX
 	// cards, perhaps hacked support for some special emulator-specific memcard formats that
 	// had header info?), then please replace this comment with something useful.  Thanks!  -- air
@@ -417,7 +460,68 @@ bool FileMemoryCard::Seek(std::FILE* f, u32 adr)
 		// perform sanity checks here?
 	}
 
-	return (FileSystem::FSeek64(f, adr + offset, SEEK_SET) == 0);
+	return offset;
+}
+
+// Returns FALSE if the seek failed (is outside the bounds of the file).
+bool FileMemoryCard::Seek(std::FILE* f, u32 adr)
+{
+	return (FileSystem::FSeek64(f, adr + GetDataOffset(FileSystem::FSize64(f)), SEEK_SET) == 0);
+}
+
+// Returns FALSE if the range is outside the bounds of the file, or the read failed.
+bool FileMemoryCard::ReadData(uint slot, void* dest, u32 adr, u32 size)
+{
+	if (m_mapping[slot])
+	{
+		const u64 start = static_cast<u64>(adr) + m_offset[slot];
+		if ((start + size) > m_mapsize[slot])
+			return false;
+
+		std::memcpy(dest, m_mapping[slot] + start, size);
+		return true;
+	}
+
+	return Seek(m_file[slot], adr) && std::fread(dest, size, 1, m_file[slot]) == 1;
+}
+
+// Returns FALSE if the range is outside the bounds of the file, or the write failed.
+bool FileMemoryCard::WriteData(uint slot, const void* src, u32 adr, u32 size)
+{
+	if (m_mapping[slot])
+	{
+		const u64 start = static_cast<u64>(adr) + m_offset[slot];
+		if ((start + size) > m_mapsize[slot])
+			return false;
+
+		std::memcpy(m_mapping[slot] + start, src, size);
+
+		const u32 end = static_cast<u32>(start + size);
+		if (m_dirtyend[slot] == 0)
+		{
+			m_dirtystart[slot] = static_cast<u32>(start);
+			m_dirtyend[slot] = end;
+		}
+		else
+		{
+			m_dirtystart[slot] = std::min(m_dirtystart[slot], static_cast<u32>(start));
+			m_dirtyend[slot] = std::max(m_dirtyend[slot], end);
+		}
+
+		return true;
+	}
+
+	return Seek(m_file[slot], adr) && std::fwrite(src, size, 1, m_file[slot]) == 1;
+}
+
+void FileMemoryCard::FlushDirtyRange(uint slot)
+{
+	if (!m_mapping[slot] || m_dirtyend[slot] == 0)
+		return;
+
+	HostSys::FlushMappedFile(m_mapping[slot] + m_dirtystart[slot], m_dirtyend[slot] - m_dirtystart[slot]);
+	m_dirtystart[slot] = 0;
+	m_dirtyend[slot] = 0;
 }
 
 // returns FALSE if an error occurred (either permission denied or disk full)
@@ -473,9 +577,7 @@ s32 FileMemoryCard::Read(uint slot, u8* dest, u32 adr, int size)
 		memset(dest, 0, size);
 		return 1;
 	}
-	if (!Seek(mcfp, adr))
-		return 0;
-	return std::fread(dest, size, 1, mcfp) == 1;
+	return ReadData(slot, dest, adr, size);
 }
 
 s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
@@ -496,12 +598,9 @@ s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
 	}
 	else
 	{
-		if (!Seek(mcfp, adr))
-			return 0;
 		m_currentdata.MakeRoomFor(size);
 
-		const size_t read_result = std::fread(m_currentdata.GetPtr(), size, 1, mcfp);
-		if (read_result == 0)
+		if (!ReadData(slot, m_currentdata.GetPtr(), adr, size))
 			Host::ReportFormattedErrorAsync("Memory Card", "Error reading memcard.\n");
 
 		for (int i = 0; i < size; i++)
@@ -524,10 +623,7 @@ s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
 		}
 	}
 
-	if (!Seek(mcfp, adr))
-		return 0;
-
-	if (std::fwrite(m_currentdata.GetPtr(), size, 1, mcfp) == 1)
+	if (WriteData(slot, m_currentdata.GetPtr(), adr, size))
 	{
 		static auto last = std::chrono::time_point<std::chrono::system_clock>();
 
@@ -554,9 +650,7 @@ s32 FileMemoryCard::EraseBlock(uint slot, u32 adr)
 		return 1;
 	}
 
-	if (!Seek(mcfp, adr))
-		return 0;
-	return std::fwrite(m_effeffs, sizeof(m_effeffs), 1, mcfp) == 1;
+	return WriteData(slot, m_effeffs, adr, sizeof(m_effeffs));
 }
 
 u64 FileMemoryCard::GetCRC(uint slot)
@@ -569,9 +663,6 @@ u64 FileMemoryCard::GetCRC(uint slot)
 
 	if (m_ispsx[slot])
 	{
-		if (!Seek(mcfp, 0))
-			return 0;
-
 		const s64 mcfpsize = FileSystem::FSize64(mcfp);
 		if (mcfpsize < 0)
 			return 0;
@@ -581,9 +672,9 @@ u64 FileMemoryCard::GetCRC(uint slot)
 		u64 buffer[528 * 8]; // use 528 (sector size), ensures even divisibility
 
 		const uint filesize = static_cast<uint>(mcfpsize) / sizeof(buffer);
-		for (uint i = filesize; i; --i)
+		for (uint i = 0; i < filesize; i++)
 		{
-			if (std::fread(buffer, sizeof(buffer), 1, mcfp) != 1)
+			if (!ReadData(slot, buffer, i * sizeof(buffer), sizeof(buffer)))
 				return 0;
 
 			for (uint t = 0; t < std::size(buffer); ++t)
@@ -598,6 +689,11 @@ u64 FileMemoryCard::GetCRC(uint slot)
 	return retval;
 }
 
+void FileMemoryCard::NextFrame(uint slot)
+{
+	FlushDirtyRange(slot);
+}
+
 // --------------------------------------------------------------------------------------
 //  MemoryCard Component API Bindings
 // --------------------------------------------------------------------------------------
@@ -759,9 +855,9 @@ void FileMcd_NextFrame(uint port, uint slot)
 	const uint combinedSlot = FileMcd_ConvertToSlot(port, slot);
 	switch (EmuConfig.Mcd[combinedSlot].Type)
 	{
-		//case MemoryCardType::MemoryCard_File:
-		//	Mcd::impl.NextFrame( combinedSlot );
-		//	break;
+		case MemoryCardType::File:
+			Mcd::impl.NextFrame(combinedSlot);
+			break;
 		case MemoryCardType::Folder:
 			Mcd::implFolder.NextFrame(combinedSlot);
 			break;
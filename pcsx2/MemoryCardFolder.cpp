@@ -28,6 +28,7 @@
 #include "common/FileSystem.h"
 #include "common/Path.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 #include "common/Timer.h"
 
 #include "fmt/core.h"
@@ -42,7 +43,9 @@
 
 static ryml::Tree parseYamlStr(const std::string& str)
 {
-	ryml::Callbacks rymlCallbacks = ryml::get_callbacks();
+	// Put back whatever was installed before, the GameDB keeps its callbacks set.
+	const ryml::Callbacks previousCallbacks = ryml::get_callbacks();
+	ryml::Callbacks rymlCallbacks = previousCallbacks;
 	rymlCallbacks.m_error = [](const char* msg, size_t msg_len, ryml::Location loc, void*) {
 		throw std::runtime_error(fmt::format("[YAML] Parsing error at {}:{} (bufpos={}): {}",
 			loc.line, loc.col, loc.offset, msg));
@@ -52,9 +55,18 @@ static ryml::Tree parseYamlStr(const std::string& str)
 		throw std::runtime_error(fmt::format("[YAML] Internal Parsing error: {}",
 			msg));
 	});
-	ryml::Tree tree = ryml::parse_in_arena(c4::to_csubstr(str));
+	ryml::Tree tree;
+	try
+	{
+		tree = ryml::parse_in_arena(c4::to_csubstr(str));
+	}
+	catch (...)
+	{
+		ryml::set_callbacks(previousCallbacks);
+		throw;
+	}
 
-	ryml::reset_callbacks();
+	ryml::set_callbacks(previousCallbacks);
 	return tree;
 }
 
@@ -74,7 +86,6 @@ static std::optional<ryml::Tree> loadYamlFile(const char* filePath)
 	catch (const std::exception& e)
 	{
 		Console.Error(fmt::format("[MemoryCard] Error occured when parsing folder memory card at path '{}': {}", filePath, e.what()));
-		ryml::reset_callbacks();
 		return std::nullopt;
 	}
 }
@@ -135,8 +146,21 @@ FolderMemoryCard::FolderMemoryCard()
 {
 }
 
+FolderMemoryCard::~FolderMemoryCard()
+{
+	WaitForBackgroundFlush();
+}
+
+void FolderMemoryCard::WaitForBackgroundFlush() const
+{
+	if (m_flushThread.joinable())
+		m_flushThread.join();
+}
+
 void FolderMemoryCard::InitializeInternalData()
 {
+	WaitForBackgroundFlush();
+
 	memset(&m_superBlock, 0xFF, sizeof(m_superBlock));
 	memset(&m_indirectFat, 0xFF, sizeof(m_indirectFat));
 	memset(&m_fat, 0xFF, sizeof(m_fat));
@@ -224,6 +248,9 @@ void FolderMemoryCard::Close(bool flush)
 		return;
 	}
 
+	// anything written since the last background flush is written out here instead
+	WaitForBackgroundFlush();
+
 	if (flush)
 	{
 		Flush();
@@ -730,6 +757,8 @@ s32 FolderMemoryCard::IsPresent() const
 
 void FolderMemoryCard::GetSizeInfo(McdSizeInfo& outways) const
 {
+	WaitForBackgroundFlush();
+
 	outways.SectorSize = PageSize;
 	outways.EraseBlockSizeInSectors = BlockSize / PageSize;
 	outways.McdSizeInSectors = GetSizeInClusters() * 2;
@@ -958,6 +987,8 @@ bool FolderMemoryCard::ReadFromFile(u8* dest, u32 adr, u32 dataLength)
 
 s32 FolderMemoryCard::Read(u8* dest, u32 adr, int size)
 {
+	WaitForBackgroundFlush();
+
 	//const u32 block = adr / BlockSizeRaw;
 	const u32 page = adr / PageSizeRaw;
 	const u32 offset = adr % PageSizeRaw;
@@ -1037,6 +1068,8 @@ void FolderMemoryCard::ReadDataWithoutCache(u8* const dest, const u32 adr, const
 
 s32 FolderMemoryCard::Save(const u8* src, u32 adr, int size)
 {
+	WaitForBackgroundFlush();
+
 	//const u32 block = adr / BlockSizeRaw;
 	//const u32 cluster = adr / ClusterSizeRaw;
 	const u32 page = adr / PageSizeRaw;
@@ -1083,10 +1116,32 @@ s32 FolderMemoryCard::Save(const u8* src, u32 adr, int size)
 
 void FolderMemoryCard::NextFrame()
 {
+	// the background flush owns the card until it's done
+	if (m_flushInProgress.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
 	if (m_framesUntilFlush > 0 && --m_framesUntilFlush == 0)
 	{
-		Flush();
+		FlushInBackground();
+	}
+}
+
+void FolderMemoryCard::FlushInBackground()
+{
+	WaitForBackgroundFlush();
+	if (m_cache.empty())
+	{
+		return;
 	}
+
+	m_flushInProgress.store(true, std::memory_order_release);
+	m_flushThread = std::thread([this]() {
+		Threading::SetNameOfCurrentThread("Memory Card Flush");
+		Flush();
+		m_flushInProgress.store(false, std::memory_order_release);
+	});
 }
 
 void FolderMemoryCard::Flush()
@@ -1670,6 +1725,8 @@ s32 FolderMemoryCard::EraseBlock(u32 adr)
 
 u64 FolderMemoryCard::GetCRC() const
 {
+	WaitForBackgroundFlush();
+
 	// Since this is just used as integrity check for savestate loading,
 	// give a timestamp of the last time the memory card was written to
 	return m_timeLastWritten;
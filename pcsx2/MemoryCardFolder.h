@@ -18,6 +18,7 @@
 #include <map>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include "Config.h"
@@ -301,6 +302,11 @@ protected:
 	// used to figure out if contents were changed for savestate-related purposes, see GetCRC()
 	u64 m_timeLastWritten;
 
+	// flushes triggered by NextFrame() run on this thread, so the emulation thread doesn't wait on the
+	// host file system; every other access to the card waits for it to finish first
+	mutable std::thread m_flushThread;
+	std::atomic_bool m_flushInProgress{false};
+
 	// remembers and keeps the last accessed file open for further access
 	FileAccessHelper m_lastAccessedFile;
 
@@ -321,7 +327,7 @@ protected:
 
 public:
 	FolderMemoryCard();
-	virtual ~FolderMemoryCard() = default;
+	virtual ~FolderMemoryCard();
 
 	void Lock();
 	void Unlock();
@@ -377,6 +383,12 @@ protected:
 	// initializes memory card data, as if it was fresh from the factory
 	void InitializeInternalData();
 
+	// starts flushing the cache to the file system on m_flushThread
+	void FlushInBackground();
+
+	// waits for a flush started by FlushInBackground() to complete
+	void WaitForBackgroundFlush() const;
+
 	bool IsFormatted() const;
 
 	// returns the in-memory address of data the given memory card adr corresponds to
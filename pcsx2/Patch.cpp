@@ -25,19 +25,27 @@
 #include "Config.h"
 #include "Patch.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <vector>
 
-// This is a declaration for PatchMemory.cpp::_ApplyPatch where we're (patch.cpp)
+// This is a declaration for PatchMemory.cpp::_ApplyCompiledPatches where we're (patch.cpp)
 // the only consumer, so it's not made public via Patch.h
-// Applies a single patch line to emulation memory regardless of its "place" value.
-extern void _ApplyPatch(IniPatch* p);
+// Applies compiled patches to emulation memory, returns the number of writes which changed memory.
+extern u32 _ApplyCompiledPatches(const CompiledPatch* patches, size_t count);
 extern void _ApplyDynaPatch(const DynamicPatch& patch, u32 address);
 
 static std::vector<IniPatch> Patch;
 static std::vector<DynamicPatch> DynaPatch;
 
+static std::vector<CompiledPatch> CompiledPatches[_PPT_END_MARKER];
+static u32 CompiledPatchWrites[_PPT_END_MARKER];
+static bool PatchesCompiled = false;
+
+static u64 PatchWrites = 0;
+static u64 PatchWritesChanged = 0;
+
 struct PatchTextTable
 {
 	int code;
@@ -140,8 +148,23 @@ int LoadPatchesFromString(const std::string& patches)
 
 void ForgetLoadedPatches()
 {
+	if (PatchWrites > 0)
+	{
+		DevCon.WriteLn("(Patch) %llu of %llu patch writes changed memory.",
+			static_cast<unsigned long long>(PatchWritesChanged), static_cast<unsigned long long>(PatchWrites));
+	}
+
 	Patch.clear();
 	DynaPatch.clear();
+
+	for (int place = 0; place < _PPT_END_MARKER; place++)
+	{
+		CompiledPatches[place].clear();
+		CompiledPatchWrites[place] = 0;
+	}
+	PatchesCompiled = false;
+	PatchWrites = 0;
+	PatchWritesChanged = 0;
 }
 
 // This routine loads patches from a zip file
@@ -275,19 +298,146 @@ namespace PatchFunc
 
 		iPatch.enabled = 1;
 		Patch.push_back(iPatch);
+		PatchesCompiled = false;
 
 #undef PATCH_ERROR
 	}
 } // namespace PatchFunc
 
-// This is for applying patches directly to memory
-void ApplyLoadedPatches(patch_place_type place)
+static bool CompilePatch(IniPatch& p, CompiledPatch& cp)
+{
+	cp = {};
+	cp.cpu = p.cpu;
+	cp.addr = p.addr;
+
+	switch (p.type)
+	{
+		case BYTE_T:
+			cp.size = 1;
+			cp.value = static_cast<u8>(p.data);
+			break;
+		case SHORT_T:
+			cp.size = 2;
+			cp.value = static_cast<u16>(p.data);
+			break;
+		case WORD_T:
+			cp.size = 4;
+			cp.value = static_cast<u32>(p.data);
+			break;
+		case DOUBLE_T:
+			cp.size = 8;
+			cp.value = p.data;
+			break;
+		case SHORT_LE_T:
+			cp.size = 2;
+			cp.value = static_cast<u16>(SwapEndian(p.data, 16));
+			break;
+		case WORD_LE_T:
+			cp.size = 4;
+			cp.value = static_cast<u32>(SwapEndian(p.data, 32));
+			break;
+		case DOUBLE_LE_T:
+			cp.size = 8;
+			cp.value = SwapEndian(p.data, 64);
+			break;
+		case EXTENDED_T:
+			cp.extended = &p;
+			return (p.cpu == CPU_EE);
+		default:
+			return false;
+	}
+
+	// The IOP only ever supported the big endian byte/short/word types.
+	return (p.cpu == CPU_EE || (p.cpu == CPU_IOP && p.type <= WORD_T));
+}
+
+// Sorts a run of plain writes by address, so writes to the same page end up next to each other.
+// Exact duplicates are dropped in favour of the last one. If the run has partially overlapping
+// writes, the result depends on the order, so the run is left as it was in the pnach.
+static void SortPatchRun(std::vector<CompiledPatch>& list, size_t start)
 {
-	for (auto& i : Patch)
+	const auto begin = list.begin() + start;
+	if (list.end() - begin < 2)
+		return;
+
+	std::vector<CompiledPatch> run(begin, list.end());
+	std::stable_sort(run.begin(), run.end(), [](const CompiledPatch& lhs, const CompiledPatch& rhs) {
+		return (lhs.cpu != rhs.cpu) ? (lhs.cpu < rhs.cpu) : (lhs.addr < rhs.addr);
+	});
+
+	std::vector<CompiledPatch> sorted;
+	sorted.reserve(run.size());
+	for (const CompiledPatch& cp : run)
 	{
-		if (i.placetopatch == place)
-			_ApplyPatch(&i);
+		if (!sorted.empty())
+		{
+			CompiledPatch& prev = sorted.back();
+			if (prev.cpu == cp.cpu && prev.addr == cp.addr && prev.size == cp.size)
+			{
+				prev = cp;
+				continue;
+			}
+			else if (prev.cpu == cp.cpu && (prev.addr + prev.size) > cp.addr)
+			{
+				return;
+			}
+		}
+
+		sorted.push_back(cp);
 	}
+
+	list.erase(begin, list.end());
+	list.insert(list.end(), sorted.begin(), sorted.end());
+}
+
+static void CompileLoadedPatches()
+{
+	for (int place = 0; place < _PPT_END_MARKER; place++)
+	{
+		std::vector<CompiledPatch>& list = CompiledPatches[place];
+		list.clear();
+		size_t run_start = 0;
+
+		for (IniPatch& p : Patch)
+		{
+			CompiledPatch cp;
+			if (p.placetopatch != place || !p.enabled || !CompilePatch(p, cp))
+				continue;
+
+			// Extended codes can read memory and skip the following lines, so their order is kept.
+			if (cp.extended)
+			{
+				SortPatchRun(list, run_start);
+				list.push_back(cp);
+				run_start = list.size();
+			}
+			else
+			{
+				list.push_back(cp);
+			}
+		}
+
+		SortPatchRun(list, run_start);
+
+		CompiledPatchWrites[place] = static_cast<u32>(std::count_if(list.begin(), list.end(),
+			[](const CompiledPatch& cp) { return !cp.extended; }));
+	}
+
+	PatchesCompiled = true;
+}
+
+// This is for applying patches directly to memory
+void ApplyLoadedPatches(patch_place_type place)
+{
+	if (!PatchesCompiled)
+		CompileLoadedPatches();
+
+	const std::vector<CompiledPatch>& list = CompiledPatches[place];
+	if (list.empty())
+		return;
+
+	PatchWrites += CompiledPatchWrites[place];
+	PatchWritesChanged += _ApplyCompiledPatches(list.data(), list.size());
 }
 
 void ApplyDynamicPatches(u32 pc)
@@ -97,6 +97,17 @@ struct IniPatch
 	u64 data;
 };
 
+// Loaded patches are compiled into a flat list of these before being applied, so applying them
+// every vsync is just a compare (and, if memory differs, a write) per entry.
+struct CompiledPatch
+{
+	IniPatch* extended; // extended (cheat device) code, run through the code interpreter in order
+	patch_cpu_type cpu;
+	u32 size; // in bytes, for plain writes
+	u32 addr;
+	u64 value; // already byte swapped for the little endian types
+};
+
 struct DynamicPatchEntry
 {
 	u32 offset;
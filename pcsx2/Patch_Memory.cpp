@@ -505,89 +505,109 @@ void handle_extended_t(IniPatch *p)
 	}
 }
 
+static __fi u64 ReadCompiledPatch(const CompiledPatch& cp)
+{
+	if (cp.cpu == CPU_IOP)
+	{
+		switch (cp.size)
+		{
+			case 1: return iopMemRead8(cp.addr);
+			case 2: return iopMemRead16(cp.addr);
+			default: return iopMemRead32(cp.addr);
+		}
+	}
+
+	switch (cp.size)
+	{
+		case 1: return memRead8(cp.addr);
+		case 2: return memRead16(cp.addr);
+		case 4: return memRead32(cp.addr);
+		default: return memRead64(cp.addr);
+	}
+}
+
+static __fi void WriteCompiledPatch(const CompiledPatch& cp)
+{
+	if (cp.cpu == CPU_IOP)
+	{
+		switch (cp.size)
+		{
+			case 1: iopMemWrite8(cp.addr, static_cast<u8>(cp.value)); break;
+			case 2: iopMemWrite16(cp.addr, static_cast<u16>(cp.value)); break;
+			default: iopMemWrite32(cp.addr, static_cast<u32>(cp.value)); break;
+		}
+		return;
+	}
+
+	switch (cp.size)
+	{
+		case 1: memWrite8(cp.addr, static_cast<u8>(cp.value)); break;
+		case 2: memWrite16(cp.addr, static_cast<u16>(cp.value)); break;
+		case 4: memWrite32(cp.addr, static_cast<u32>(cp.value)); break;
+		default: memWrite64(cp.addr, cp.value); break;
+	}
+}
+
 // Only used from Patch.cpp and we don't export this in any h file.
 // Patch.cpp itself declares this prototype, so make sure to keep in sync.
-void _ApplyPatch(IniPatch *p)
+u32 _ApplyCompiledPatches(const CompiledPatch* patches, size_t count)
 {
-	u64 ledata = 0;
+	static constexpr u32 NO_PAGE = 0xFFFFFFFFu;
+	u32 changed = 0;
 
-	if (p->enabled == 0) return;
+	// EE code pages which are write protected by the recompiler are unlocked while we patch them,
+	// and only the blocks covering the patched words get cleared. Writing normally would fault,
+	// and the fault handler throws every block in the page away and leaves it self-checking.
+	// Writes are sorted by address, so each page only gets unlocked once.
+	u32 unlocked_page = NO_PAGE;
 
-	switch (p->cpu)
+	for (size_t i = 0; i < count; i++)
 	{
-	case CPU_EE:
-		switch (p->type)
+		const CompiledPatch& cp = patches[i];
+		if (cp.extended)
 		{
-		case BYTE_T:
-			if (memRead8(p->addr) != (u8)p->data)
-				memWrite8(p->addr, (u8)p->data);
-			break;
-
-		case SHORT_T:
-			if (memRead16(p->addr) != (u16)p->data)
-				memWrite16(p->addr, (u16)p->data);
-			break;
-
-		case WORD_T:
-			if (memRead32(p->addr) != (u32)p->data)
-				memWrite32(p->addr, (u32)p->data);
-			break;
-
-		case DOUBLE_T:
-			if (memRead64(p->addr) != (u64)p->data)
-				memWrite64(p->addr, (u64)p->data);
-			break;
-
-		case EXTENDED_T:
-			handle_extended_t(p);
-			break;
-
-		case SHORT_LE_T:
-			ledata = SwapEndian(p->data, 16);
-			if (memRead16(p->addr) != (u16)ledata)
-				memWrite16(p->addr, (u16)ledata);
-			break;
-
-		case WORD_LE_T:
-			ledata = SwapEndian(p->data, 32);
-			if (memRead32(p->addr) != (u32)ledata)
-				memWrite32(p->addr, (u32)ledata);
-			break;
-
-		case DOUBLE_LE_T:
-			ledata = SwapEndian(p->data, 64);
-			if (memRead64(p->addr) != (u64)ledata)
-				memWrite64(p->addr, (u64)ledata);
-			break;
-
-		default:
-			break;
+			// Extended codes write through the normal path, which must see the page protected.
+			if (unlocked_page != NO_PAGE)
+			{
+				mmap_SetCountedRamPageWritable(unlocked_page, false);
+				unlocked_page = NO_PAGE;
+			}
+
+			handle_extended_t(cp.extended);
+			continue;
 		}
-		break;
 
-	case CPU_IOP:
-		switch (p->type)
+		if (ReadCompiledPatch(cp) == cp.value)
+			continue;
+
+		changed++;
+
+		if (cp.cpu == CPU_IOP)
 		{
-		case BYTE_T:
-			if (iopMemRead8(p->addr) != (u8)p->data)
-				iopMemWrite8(p->addr, (u8)p->data);
-			break;
-		case SHORT_T:
-			if (iopMemRead16(p->addr) != (u16)p->data)
-				iopMemWrite16(p->addr, (u16)p->data);
-			break;
-		case WORD_T:
-			if (iopMemRead32(p->addr) != (u32)p->data)
-				iopMemWrite32(p->addr, (u32)p->data);
-			break;
-		default:
-			break;
+			WriteCompiledPatch(cp);
+			continue;
 		}
-		break;
 
-	default:
-		break;
+		const u32 page = cp.addr & ~__pagemask;
+		if (page != unlocked_page && mmap_GetRamPageInfo(page) == ProtMode_Write)
+		{
+			if (unlocked_page != NO_PAGE)
+				mmap_SetCountedRamPageWritable(unlocked_page, false);
+
+			mmap_SetCountedRamPageWritable(page, true);
+			unlocked_page = page;
+		}
+
+		WriteCompiledPatch(cp);
+
+		if (page == unlocked_page)
+			mmap_ClearCountedRamWords(cp.addr & ~3u, (cp.size + 3) / 4);
 	}
+
+	if (unlocked_page != NO_PAGE)
+		mmap_SetCountedRamPageWritable(unlocked_page, false);
+
+	return changed;
 }
 
 void _ApplyDynaPatch(const DynamicPatch& patch, u32 address)
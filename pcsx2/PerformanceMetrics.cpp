@@ -28,6 +28,7 @@
 #include "GS/GSCapture.h"
 #include "MTVU.h"
 #include "VMManager.h"
+#include "x86/newVif.h"
 
 static const float UPDATE_INTERVAL = 0.5f;
 
@@ -69,6 +70,11 @@ static float s_vu_thread_time = 0.0f;
 static float s_capture_thread_usage = 0.0f;
 static float s_capture_thread_time = 0.0f;
 
+static nVifCacheCounters s_last_vif_counters = {};
+static float s_vif_cache_hit_rate = 0.0f;
+static float s_vif_cache_average_probes = 0.0f;
+static float s_vif_cache_compile_rate = 0.0f;
+
 static PerformanceMetrics::FrameTimeHistory s_frame_time_history;
 static u32 s_frame_time_history_pos = 0;
 
@@ -106,6 +112,10 @@ void PerformanceMetrics::Clear()
 	s_capture_thread_usage = 0.0f;
 	s_capture_thread_time = 0.0f;
 
+	s_vif_cache_hit_rate = 0.0f;
+	s_vif_cache_average_probes = 0.0f;
+	s_vif_cache_compile_rate = 0.0f;
+
 	s_average_gpu_time = 0.0f;
 	s_gpu_usage = 0.0f;
 
@@ -139,6 +149,8 @@ void PerformanceMetrics::Reset()
 
 	for (GSSWThreadStats& stat : s_gs_sw_threads)
 		stat.last_cpu_time = stat.handle.GetCPUTime();
+
+	s_last_vif_counters = dVifGetCacheCounters();
 }
 
 void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_skipping_present)
@@ -236,6 +248,17 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 		thread.time = static_cast<double>(delta) * time_divider;
 	}
 
+	if (EmuConfig.GS.OsdShowVIFStats)
+	{
+		const nVifCacheCounters vif = dVifGetCacheCounters();
+		const u64 vif_hits = vif.hits - s_last_vif_counters.hits;
+		const u64 vif_lookups = vif_hits + (vif.misses - s_last_vif_counters.misses);
+		s_vif_cache_hit_rate = vif_lookups ? (static_cast<float>(vif_hits) * 100.0f / static_cast<float>(vif_lookups)) : 0.0f;
+		s_vif_cache_average_probes = vif_lookups ? (static_cast<float>(vif.probes - s_last_vif_counters.probes) / static_cast<float>(vif_lookups)) : 0.0f;
+		s_vif_cache_compile_rate = static_cast<float>(vif.compiles - s_last_vif_counters.compiles) / time;
+		s_last_vif_counters = vif;
+	}
+
 	s_frames_since_last_update = 0;
 	s_unskipped_frames_since_last_update = 0;
 	s_presents_since_last_update = 0;
@@ -357,6 +380,21 @@ float PerformanceMetrics::GetCaptureThreadAverageTime()
 	return s_capture_thread_time;
 }
 
+float PerformanceMetrics::GetVIFCacheHitRate()
+{
+	return s_vif_cache_hit_rate;
+}
+
+float PerformanceMetrics::GetVIFCacheAverageProbes()
+{
+	return s_vif_cache_average_probes;
+}
+
+float PerformanceMetrics::GetVIFCacheCompileRate()
+{
+	return s_vif_cache_compile_rate;
+}
+
 u32 PerformanceMetrics::GetGSSWThreadCount()
 {
 	return static_cast<u32>(s_gs_sw_threads.size());
@@ -66,6 +66,11 @@ namespace PerformanceMetrics
 	float GetCaptureThreadUsage();
 	float GetCaptureThreadAverageTime();
 
+	/// newVif unpack block cache: hit percentage, probes per lookup and compiles per second.
+	float GetVIFCacheHitRate();
+	float GetVIFCacheAverageProbes();
+	float GetVIFCacheCompileRate();
+
 	u32 GetGSSWThreadCount();
 	double GetGSSWThreadUsage(u32 index);
 	double GetGSSWThreadAverageTime(u32 index);
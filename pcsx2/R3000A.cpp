@@ -44,6 +44,10 @@ bool iopEventAction = false;
 
 bool iopEventTestIsActive = false;
 
+// Earliest cycle at which one of the pending psxRegs.interrupt events becomes due; see the
+// EE's eeNextInterruptCycle.
+static u32 iopNextInterruptCycle = 0;
+
 alignas(16) psxRegisters psxRegs;
 
 void psxReset()
@@ -57,6 +61,7 @@ void psxReset()
 	psxRegs.iopBreak = 0;
 	psxRegs.iopCycleEE = -1;
 	psxRegs.iopNextEventCycle = psxRegs.cycle + 4;
+	iopNextInterruptCycle = psxRegs.cycle;
 
 	psxHwReset();
 	PSXCLK = 36864000;
@@ -119,6 +124,23 @@ __fi void psxSetNextBranchDelta( s32 delta )
 	psxSetNextBranch( psxRegs.cycle, delta );
 }
 
+// records when a pending interrupt becomes due, and makes sure a branch test happens by then.
+static __fi void psxScheduleInterrupt( u32 startCycle, s32 delta )
+{
+	const u32 dueCycle = startCycle + delta;
+	if( (int)(dueCycle - psxRegs.cycle) < (int)(iopNextInterruptCycle - psxRegs.cycle) )
+		iopNextInterruptCycle = dueCycle;
+
+	psxSetNextBranch( startCycle, delta );
+}
+
+// forces the next branch test to walk every pending interrupt, e.g. after loading a state.
+void psxRescheduleInterrupts()
+{
+	iopNextInterruptCycle = psxRegs.cycle;
+	psxRegs.iopNextEventCycle = psxRegs.cycle;
+}
+
 __fi int psxTestCycle( u32 startCycle, s32 delta )
 {
 	// typecast the conditional to signed so that things don't explode
@@ -138,7 +160,7 @@ __fi void PSX_INT( IopEventId n, s32 ecycle )
 	psxRegs.sCycle[n] = psxRegs.cycle;
 	psxRegs.eCycle[n] = ecycle;
 
-	psxSetNextBranchDelta(ecycle);
+	psxScheduleInterrupt(psxRegs.cycle, ecycle);
 
 	if (psxRegs.iopCycleEE < 0)
 	{
@@ -160,7 +182,7 @@ static __fi void IopTestEvent( IopEventId n, void (*callback)() )
 		callback();
 	}
 	else
-		psxSetNextBranch( psxRegs.sCycle[n], psxRegs.eCycle[n] );
+		psxScheduleInterrupt( psxRegs.sCycle[n], psxRegs.eCycle[n] );
 }
 
 static __fi void Sio0TestEvent(IopEventId n)
@@ -177,12 +199,22 @@ static __fi void Sio0TestEvent(IopEventId n)
 	}
 	else
 	{
-		psxSetNextBranch(psxRegs.sCycle[n], psxRegs.eCycle[n]);
+		psxScheduleInterrupt(psxRegs.sCycle[n], psxRegs.eCycle[n]);
 	}
 }
 
 static __fi void _psxTestInterrupts()
 {
+	// Nothing pending is due yet, so there is no need to look at each event.
+	if (!psxTestCycle(iopNextInterruptCycle, 0))
+	{
+		psxSetNextBranch(iopNextInterruptCycle, 0);
+		return;
+	}
+
+	// Anything still pending after the walk (or raised by a callback) pulls this back in.
+	iopNextInterruptCycle = psxRegs.cycle + 0x7fffffff;
+
 	IopTestEvent(IopEvt_SIF0,		sif0Interrupt);	// SIF0
 	IopTestEvent(IopEvt_SIF1,		sif1Interrupt);	// SIF1
 	IopTestEvent(IopEvt_SIF2,		sif2Interrupt);	// SIF2
@@ -205,6 +205,7 @@ extern R3000Acpu psxInt;
 extern R3000Acpu psxRec;
 
 extern void psxReset();
+extern void psxRescheduleInterrupts();
 extern void psxException(u32 code, u32 step);
 extern void iopEventTest();
 extern void psxMemReset();
@@ -59,6 +59,11 @@ static const uint eeWaitCycles = 3072;
 
 bool eeEventTestIsActive = false;
 
+// Earliest cycle at which one of the pending cpuRegs.interrupt events becomes due. The event
+// test only walks the interrupt list once this has passed. It is recomputed by that walk and
+// only ever lowered in between, so a stale value costs an extra walk rather than a late event.
+static u32 eeNextInterruptCycle = 0;
+
 u32 g_eeloadMain = 0, g_eeloadExec = 0, g_osdsys_str = 0;
 
 /* I don't know how much space for args there is in the memory block used for args in full boot mode,
@@ -93,6 +98,7 @@ void cpuReset()
 	fpuRegs.fprc[31]		= 0x01000001; // fpu Status/Control
 
 	cpuRegs.nextEventCycle = cpuRegs.cycle + 4;
+	eeNextInterruptCycle = cpuRegs.cycle;
 	EEsCycle = 0;
 	EEoCycle = cpuRegs.cycle;
 
@@ -262,6 +268,23 @@ __fi int cpuTestCycle( u32 startCycle, s32 delta )
 	return (int)(cpuRegs.cycle - startCycle) >= delta;
 }
 
+// records when a pending interrupt becomes due, and makes sure an event test happens by then.
+static __fi void cpuScheduleInterrupt( u32 startCycle, s32 delta )
+{
+	const u32 dueCycle = startCycle + delta;
+	if( (int)(dueCycle - cpuRegs.cycle) < (int)(eeNextInterruptCycle - cpuRegs.cycle) )
+		eeNextInterruptCycle = dueCycle;
+
+	cpuSetNextEvent( startCycle, delta );
+}
+
+// forces the next event test to walk every pending interrupt, e.g. after loading a state.
+void cpuRescheduleInterrupts()
+{
+	eeNextInterruptCycle = cpuRegs.cycle;
+	cpuSetEvent();
+}
+
 // tells the EE to run the branch test the next time it gets a chance.
 __fi void cpuSetEvent()
 {
@@ -285,7 +308,7 @@ static __fi void TESTINT( u8 n, void (*callback)() )
 		callback();
 	}
 	else
-		cpuSetNextEvent( cpuRegs.sCycle[n], cpuRegs.eCycle[n] );
+		cpuScheduleInterrupt( cpuRegs.sCycle[n], cpuRegs.eCycle[n] );
 }
 
 // [TODO] move this function to Dmac.cpp, and remove most of the DMAC-related headers from
@@ -298,6 +321,16 @@ static __fi bool _cpuTestInterrupts()
 		//Console.Write("DMAC Disabled or suspended");
 		return false;
 	}
+
+	// Nothing pending is due yet, so there is no need to look at each event.
+	if (g_GameStarted && !CHECK_INSTANTDMAHACK && !cpuTestCycle(eeNextInterruptCycle, 0))
+	{
+		cpuSetNextEvent(eeNextInterruptCycle, 0);
+		return ((cpuRegs.interrupt & 0x1FFFF) & ~cpuRegs.dmastall) != 0;
+	}
+
+	// Anything still pending after the walk (or raised by a callback) pulls this back in.
+	eeNextInterruptCycle = cpuRegs.cycle + 0x7fffffff;
 	/* These are 'pcsx2 interrupts', they handle asynchronous stuff
 	   that depends on the cycle timings */
 	TESTINT(VU_MTVU_BUSY,	MTVUInterrupt);
@@ -565,7 +598,7 @@ __fi void CPU_INT( EE_EventType n, s32 ecycle)
 		psxRegs.iopCycleEE = 0;
 	}
 
-	cpuSetNextEventDelta(cpuRegs.eCycle[n]);
+	cpuScheduleInterrupt(cpuRegs.cycle, cpuRegs.eCycle[n]);
 }
 
 // Called from recompilers; define is mandatory.
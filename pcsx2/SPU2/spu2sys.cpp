@@ -27,6 +27,7 @@
 #include "IopCounters.h"
 #include "R3000A.h"
 #include "IopHw.h"
+#include "common/PerfTrace.h"
 
 #include "spu2.h" // needed until I figure out a nice solution for irqcallback dependencies.
 
@@ -409,6 +410,9 @@ __forceinline void TimeUpdate(u32 cClocks)
 	else
 		TickInterval = 768; // Reset to default, in case the user hotswitched from async to something else.
 
+	// Only worth a trace event when there's something to mix, this gets called a lot.
+	const Common::Timer::Value mix_start = (dClocks >= TickInterval && PerfTrace::IsEnabled()) ? Common::Timer::GetCurrentValue() : 0;
+
 	//Update Mixing Progress
 	while (dClocks >= TickInterval)
 	{
@@ -442,6 +446,9 @@ __forceinline void TimeUpdate(u32 cClocks)
 		//RestoreMMXRegs();
 	}
 
+	if (mix_start != 0)
+		PerfTrace::Record("SPU2", "Mix", mix_start, Common::Timer::GetCurrentValue());
+
 	//Update DMA4 interrupt delay counter
 	if (Cores[0].DMAICounter > 0 && (psxRegs.cycle - Cores[0].LastClock) > 0)
 	{
@@ -51,8 +51,12 @@
 
 #include "fmt/core.h"
 
+#include <atomic>
 #include <csetjmp>
 #include <png.h>
+#include <thread>
+#include <zlib.h>
+#include <zstd.h>
 
 using namespace R5900;
 
@@ -94,6 +98,25 @@ static void PostLoadPrep()
 	UpdateVSyncRate();
 }
 
+// Runs func(0) .. func(count - 1), spread over up to one thread per host core.
+template <typename Func>
+static void SaveState_ParallelFor(u32 count, const Func& func)
+{
+	const u32 num_threads = std::min(count, std::max(std::thread::hardware_concurrency(), 1u));
+	std::atomic<u32> next{0};
+	const auto worker = [&]() {
+		for (u32 i = next.fetch_add(1, std::memory_order_relaxed); i < count; i = next.fetch_add(1, std::memory_order_relaxed))
+			func(i);
+	};
+
+	std::vector<std::thread> threads;
+	for (u32 i = 1; i < num_threads; i++)
+		threads.emplace_back(worker);
+	worker();
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
 // --------------------------------------------------------------------------------------
 //  SaveStateBase  (implementations)
 // --------------------------------------------------------------------------------------
@@ -196,6 +219,13 @@ SaveStateBase& SaveStateBase::FreezeInternals()
 	Freeze(g_GameLoading);
 	Freeze(ElfCRC);
 
+	// The pending interrupt deadlines are derived from the registers above.
+	if (IsLoading())
+	{
+		cpuRescheduleInterrupts();
+		psxRescheduleInterrupts();
+	}
+
 	char localDiscSerial[256];
 	StringUtil::Strlcpy(localDiscSerial, DiscSerial.c_str(), sizeof(localDiscSerial));
 	Freeze(localDiscSerial);
@@ -404,18 +434,67 @@ static void SysState_ComponentFreezeOut(SaveStateBase& writer, SysState_Componen
 	return;
 }
 
-static void SysState_ComponentFreezeInNew(zip_file_t* zf, const char* name, bool(*do_state_func)(StateWrapper&))
+namespace
 {
-	// TODO: We could decompress on the fly here for a little bit more speed.
-	std::vector<u8> data;
-	if (zf)
+	// Decompresses a zip entry as the component reads it, instead of inflating the whole entry
+	// into a temporary buffer first. Compressed entries can only be read forwards, which is all
+	// loading needs (SkipBytes() turns into a forward SeekRelative()).
+	class ZipReadStream final : public StateWrapper::IStream
 	{
-		std::optional<std::vector<u8>> optdata(ReadBinaryFileInZip(zf));
-		if (optdata.has_value())
-			data = std::move(optdata.value());
-	}
+	public:
+		explicit ZipReadStream(zip_file_t* zf)
+			: m_zf(zf)
+		{
+		}
 
-	StateWrapper::ReadOnlyMemoryStream stream(data.empty() ? nullptr : data.data(), data.size());
+		u32 Read(void* buf, u32 count) override
+		{
+			if (!m_zf || count == 0)
+				return 0;
+
+			const zip_int64_t read = zip_fread(m_zf, buf, count);
+			if (read <= 0)
+				return 0;
+
+			m_position += static_cast<u32>(read);
+			return static_cast<u32>(read);
+		}
+
+		u32 Write(const void* buf, u32 count) override { return 0; }
+		u32 GetPosition() override { return m_position; }
+
+		bool SeekAbsolute(u32 pos) override
+		{
+			return (pos >= m_position) && SeekRelative(static_cast<s32>(pos - m_position));
+		}
+
+		bool SeekRelative(s32 count) override
+		{
+			if (count < 0)
+				return false;
+
+			u8 discard[4096];
+			u32 remaining = static_cast<u32>(count);
+			while (remaining > 0)
+			{
+				const u32 chunk = std::min<u32>(remaining, sizeof(discard));
+				if (Read(discard, chunk) != chunk)
+					return false;
+				remaining -= chunk;
+			}
+
+			return true;
+		}
+
+	private:
+		zip_file_t* m_zf;
+		u32 m_position = 0;
+	};
+} // namespace
+
+static void SysState_ComponentFreezeInNew(zip_file_t* zf, const char* name, bool(*do_state_func)(StateWrapper&))
+{
+	ZipReadStream stream(zf);
 	StateWrapper sw(&stream, StateWrapper::Mode::Read, g_SaveVersion);
 
 	// TODO: Get rid of the bloody exceptions.
@@ -456,6 +535,9 @@ public:
 	virtual void FreezeIn(zip_file_t* zf) const = 0;
 	virtual void FreezeOut(SaveStateBase& writer) const = 0;
 	virtual bool IsRequired() const = 0;
+
+	// Entries which only fill a block of memory can be loaded on any thread, in any order.
+	virtual bool IsPlainMemory() const { return false; }
 };
 
 class MemorySavestateEntry : public BaseSavestateEntry
@@ -468,6 +550,7 @@ public:
 	virtual void FreezeIn(zip_file_t* zf) const;
 	virtual void FreezeOut(SaveStateBase& writer) const;
 	virtual bool IsRequired() const { return true; }
+	virtual bool IsPlainMemory() const { return true; }
 
 protected:
 	virtual u8* GetDataPtr() const = 0;
@@ -507,12 +590,6 @@ public:
 	const char* GetFilename() const { return "eeMemory.bin"; }
 	u8* GetDataPtr() const { return eeMem->Main; }
 	uint GetDataSize() const { return sizeof(eeMem->Main); }
-
-	virtual void FreezeIn(zip_file_t* zf) const
-	{
-		SysClearExecutionCache();
-		MemorySavestateEntry::FreezeIn(zf);
-	}
 };
 
 class SavestateEntry_IopMemory : public MemorySavestateEntry
@@ -895,10 +972,106 @@ static bool SaveState_ReadScreenshot(zip_t* zf, u32* out_width, u32* out_height,
 	return true;
 }
 
+// --------------------------------------------------------------------------------------
+//  SaveStateCompressedEntry
+// --------------------------------------------------------------------------------------
+// libzip compresses entries one after another inside zip_close(). Instead, every entry is
+// compressed up front on its own thread, and handed to libzip through a source which reports
+// the data as already compressed with the entry's method, so zip_close() only copies it.
+
+struct SaveStateCompressedEntry
+{
+	const u8* data;
+	u32 size;
+	u32 crc;
+	u32 method;
+	std::vector<u8> compressed;
+	size_t read_pos;
+	zip_error_t error;
+};
+
+static bool SaveState_CompressEntry(SaveStateCompressedEntry* entry)
+{
+	entry->crc = static_cast<u32>(crc32(crc32(0, Z_NULL, 0), entry->data, entry->size));
+
+	// Same levels libzip uses when none is given.
+	if (entry->method == ZIP_CM_ZSTD)
+	{
+		entry->compressed.resize(ZSTD_compressBound(entry->size));
+		const size_t res = ZSTD_compress(entry->compressed.data(), entry->compressed.size(), entry->data, entry->size, 0);
+		if (ZSTD_isError(res))
+			return false;
+
+		entry->compressed.resize(res);
+		return true;
+	}
+
+	z_stream zs = {};
+	if (deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK)
+		return false;
+
+	entry->compressed.resize(deflateBound(&zs, entry->size));
+	zs.next_in = const_cast<Bytef*>(entry->data);
+	zs.avail_in = entry->size;
+	zs.next_out = entry->compressed.data();
+	zs.avail_out = static_cast<uInt>(entry->compressed.size());
+	const int res = deflate(&zs, Z_FINISH);
+	entry->compressed.resize(zs.total_out);
+	deflateEnd(&zs);
+	return (res == Z_STREAM_END);
+}
+
+static zip_int64_t SaveState_CompressedEntrySource(void* userdata, void* data, zip_uint64_t len, zip_source_cmd_t cmd)
+{
+	SaveStateCompressedEntry* entry = static_cast<SaveStateCompressedEntry*>(userdata);
+	switch (cmd)
+	{
+		case ZIP_SOURCE_OPEN:
+			entry->read_pos = 0;
+			return 0;
+
+		case ZIP_SOURCE_READ:
+		{
+			const size_t count = std::min<size_t>(len, entry->compressed.size() - entry->read_pos);
+			std::memcpy(data, entry->compressed.data() + entry->read_pos, count);
+			entry->read_pos += count;
+			return static_cast<zip_int64_t>(count);
+		}
+
+		case ZIP_SOURCE_CLOSE:
+		case ZIP_SOURCE_FREE:
+			return 0;
+
+		case ZIP_SOURCE_STAT:
+		{
+			zip_stat_t* st = static_cast<zip_stat_t*>(data);
+			zip_stat_init(st);
+			st->valid = ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE | ZIP_STAT_COMP_METHOD | ZIP_STAT_CRC;
+			st->size = entry->size;
+			st->comp_size = entry->compressed.size();
+			st->comp_method = static_cast<zip_uint16_t>(entry->method);
+			st->crc = entry->crc;
+			return sizeof(*st);
+		}
+
+		case ZIP_SOURCE_ERROR:
+			return zip_error_to_data(&entry->error, data, len);
+
+		case ZIP_SOURCE_SUPPORTS:
+			return zip_source_make_command_bitmap(ZIP_SOURCE_OPEN, ZIP_SOURCE_READ, ZIP_SOURCE_CLOSE,
+				ZIP_SOURCE_STAT, ZIP_SOURCE_ERROR, ZIP_SOURCE_FREE, -1);
+
+		default:
+			zip_error_set(&entry->error, ZIP_ER_OPNOTSUPP, 0);
+			return -1;
+	}
+}
+
 // --------------------------------------------------------------------------------------
 //  CompressThread_VmState
 // --------------------------------------------------------------------------------------
-static bool SaveState_AddToZip(zip_t* zf, ArchiveEntryList* srclist, SaveStateScreenshotData* screenshot)
+static bool SaveState_AddToZip(zip_t* zf, ArchiveEntryList* srclist, SaveStateScreenshotData* screenshot,
+	std::vector<SaveStateCompressedEntry>* compressed)
 {
 	// use zstd compression, it can be 10x+ faster for saving.
 	const u32 compression = EmuConfig.SavestateZstdCompression ? ZIP_CM_ZSTD : ZIP_CM_DEFLATE;
@@ -922,13 +1095,30 @@ static bool SaveState_AddToZip(zip_t* zf, ArchiveEntryList* srclist, SaveStateSc
 	}
 
 	const uint listlen = srclist->GetLength();
+	compressed->resize(listlen);
+	SaveState_ParallelFor(listlen, [srclist, compressed, compression](u32 i) {
+		const ArchiveEntry& entry = (*srclist)[i];
+		SaveStateCompressedEntry& ce = (*compressed)[i];
+		ce.data = srclist->GetPtr(entry.GetDataIndex());
+		ce.size = static_cast<u32>(entry.GetDataSize());
+		ce.method = compression;
+		ce.read_pos = 0;
+		zip_error_init(&ce.error);
+		if (ce.size > 0 && !SaveState_CompressEntry(&ce))
+			ce.compressed.clear();
+	});
+
 	for (uint i = 0; i < listlen; ++i)
 	{
 		const ArchiveEntry& entry = (*srclist)[i];
 		if (!entry.GetDataSize())
 			continue;
 
-		zip_source_t* const zs = zip_source_buffer(zf, srclist->GetPtr(entry.GetDataIndex()), entry.GetDataSize(), 0);
+		// If we couldn't compress it ourselves, let libzip have a go at it.
+		SaveStateCompressedEntry& ce = (*compressed)[i];
+		zip_source_t* const zs = ce.compressed.empty() ?
+			zip_source_buffer(zf, ce.data, ce.size, 0) :
+			zip_source_function(zf, SaveState_CompressedEntrySource, &ce);
 		if (!zs)
 			return false;
 
@@ -966,7 +1156,9 @@ bool SaveState_ZipToDisk(std::unique_ptr<ArchiveEntryList> srclist, std::unique_
 	}
 
 	// discard zip file if we fail saving something
-	if (!SaveState_AddToZip(zf, srclist.get(), screenshot.get()))
+	// the compressed entries are read during zip_close(), so they need to outlive it.
+	std::vector<SaveStateCompressedEntry> compressed;
+	if (!SaveState_AddToZip(zf, srclist.get(), screenshot.get(), &compressed))
 	{
 		Console.Error("Failed to save state to zip file '%s'", filename);
 		zip_discard(zf);
@@ -1087,10 +1279,50 @@ void SaveState_UnzipFromDisk(const std::string& filename)
 		throwIt = !LoadInternalStructuresState(zf.get(), internal_index);
 	}
 
+	if (!throwIt)
+	{
+		// EE memory is about to be overwritten, so make sure nothing compiled from it survives.
+		SysClearExecutionCache();
+
+		// Plain memory blocks are decompressed straight into place in parallel. A zip_t can't be
+		// shared between threads, so each worker opens its own handle on the archive.
+		std::vector<u32> memory_entries;
+		for (u32 i = 0; i < std::size(SavestateEntries); ++i)
+		{
+			if (entryIndices[i] >= 0 && SavestateEntries[i]->IsPlainMemory())
+				memory_entries.push_back(i);
+		}
+
+		std::atomic_bool memory_failed{false};
+		SaveState_ParallelFor(static_cast<u32>(memory_entries.size()), [&filename, &entryIndices, &memory_entries, &memory_failed](u32 i) {
+			const u32 entry = memory_entries[i];
+			zip_error_t tze = {};
+			auto tzf = zip_open_managed(filename.c_str(), ZIP_RDONLY, &tze);
+			if (!tzf)
+			{
+				memory_failed.store(true, std::memory_order_relaxed);
+				return;
+			}
+
+			auto zff = zip_fopen_index_managed(tzf.get(), entryIndices[entry], 0);
+			if (!zff)
+			{
+				memory_failed.store(true, std::memory_order_relaxed);
+				return;
+			}
+
+			SavestateEntries[entry]->FreezeIn(zff.get());
+		});
+		throwIt = memory_failed.load(std::memory_order_relaxed);
+	}
+
 	if (!throwIt)
 	{
 		for (u32 i = 0; i < std::size(SavestateEntries); ++i)
 		{
+			if (entryIndices[i] >= 0 && SavestateEntries[i]->IsPlainMemory())
+				continue;
+
 			if (entryIndices[i] < 0)
 			{
 				SavestateEntries[i]->FreezeIn(nullptr);
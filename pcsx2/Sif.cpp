@@ -21,6 +21,8 @@
 #include "Common.h"
 #include "Sif.h"
 
+bool sifBulkTransfers = true;
+
 void sifReset()
 {
 	memzero(sif0);
@@ -101,6 +101,19 @@ struct sifFifo
 		}
 		SIF_LOG("  SIF - %d = %d (pos=%d)", words, size, readPos);
 	}
+	// Leaves the FIFO as it would be after writing these FIFO_SIF_W words into it while empty and
+	// reading them all back out, for transfers which copy the data past the FIFO instead.
+	void passThrough(const u32 *from)
+	{
+		pxAssert(size == 0);
+
+		memcpy(junk, from, sizeof(junk));
+
+		const int wP0 = FIFO_SIF_W - writePos;
+		memcpy(&data[writePos], from, wP0 << 2);
+		memcpy(&data[0], &from[wP0], writePos << 2);
+	}
+
 	void clear()
 	{
 		memzero(data);
@@ -149,6 +162,9 @@ struct _sif
 
 extern _sif sif0, sif1, sif2;
 
+// Lets SIF0/SIF1 copy whole FIFO loads past the FIFO. Only turned off to check against the FIFO path.
+extern bool sifBulkTransfers;
+
 extern void sifReset();
 
 extern void SIF0Dma();
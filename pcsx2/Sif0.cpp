@@ -89,6 +89,45 @@ static __fi bool WriteIOPtoFifo()
 	return true;
 }
 
+// Copy whole FIFO loads straight from IOP to EE memory when both sides are in the middle of a
+// transfer. Each load is exactly what one pass of the SIF0Dma loop would push through an empty
+// FIFO, so the cycle counts and FIFO state come out the same. The final load is always left to
+// the normal path, which takes care of tags, junk, stall control and interrupts.
+static __fi void BulkTransfer()
+{
+	if (!sifBulkTransfers || sif0.fifo.size != 0 || !sif0.iop.busy || !sif0.ee.busy || !sif0ch.chcr.STR ||
+		sif0.iop.counter <= FIFO_SIF_W || sif0ch.qwc <= (FIFO_SIF_W >> 2))
+	{
+		return;
+	}
+
+	const u32 loads = std::min<u32>((sif0.iop.counter - 1) / FIFO_SIF_W, (sif0ch.qwc - 1) / (FIFO_SIF_W >> 2));
+	const u32 words = loads * FIFO_SIF_W;
+
+	// Both sides have to be plain RAM the whole way, otherwise let the FIFO deal with it.
+	const u32 iop_addr = hw_dma9.madr & 0x1fffff;
+	const u32 ee_addr = sif0ch.madr & 0x1ffffff0;
+	if (DMA_TAG(sif0ch.madr).SPR || (iop_addr + (words << 2)) > Ps2MemSize::IopRam ||
+		(ee_addr + (words << 2)) > Ps2MemSize::MainRam)
+	{
+		return;
+	}
+
+	SIF_LOG("Sif0: Bulk transfer %X words from %08X to %08X", words, hw_dma9.madr, sif0ch.madr);
+
+	const u32* from = (const u32*)&iopMem->Main[iop_addr];
+	std::memcpy(&eeMem->Main[ee_addr], from, words << 2);
+	sif0.fifo.passThrough(&from[words - FIFO_SIF_W]);
+
+	hw_dma9.madr += words << 2;
+	sif0.iop.cycles += words;
+	sif0.iop.counter -= words;
+
+	sif0ch.madr += words << 2;
+	sif0.ee.cycles += words >> 2;
+	sif0ch.qwc -= words >> 2;
+}
+
 // Read Fifo into an ee tag, transfer it to sif0ch, and process it.
 static __fi bool ProcessEETag()
 {
@@ -313,6 +352,8 @@ __fi void SIF0Dma()
 		//I realise this is very hacky in a way but its an easy way of checking if both are doing something
 		BusyCheck = 0;
 
+		BulkTransfer();
+
 		if (sif0.iop.counter == 0 && sif0.iop.writeJunk && sif0.fifo.sif_free() >= sif0.iop.writeJunk)
 		{
 			SIF_LOG("Writing Junk %d", sif0.iop.writeJunk);
@@ -81,6 +81,45 @@ static __fi bool WriteFifoToIOP()
 	return true;
 }
 
+// Copy whole FIFO loads straight from EE to IOP memory when both sides are in the middle of a
+// transfer, matching what that many passes of the SIF1Dma loop would do through an empty FIFO.
+// The final load is left to the normal path, along with tags, stall control and interrupts.
+static __fi void BulkTransfer()
+{
+	if (!sifBulkTransfers || sif1.fifo.size != 0 || !sif1.ee.busy || sif1_dma_stall || !sif1.iop.busy || !sif1ch.chcr.STR ||
+		dmacRegs.ctrl.STD == STD_SIF1 || sif1.iop.counter <= FIFO_SIF_W || sif1ch.qwc <= (FIFO_SIF_W >> 2))
+	{
+		return;
+	}
+
+	const u32 loads = std::min<u32>((sif1.iop.counter - 1) / FIFO_SIF_W, (sif1ch.qwc - 1) / (FIFO_SIF_W >> 2));
+	const u32 words = loads * FIFO_SIF_W;
+
+	const u32 ee_addr = sif1ch.madr & 0x1ffffff0;
+	const u32 iop_addr = hw_dma10.madr & 0x1fffff;
+	if (DMA_TAG(sif1ch.madr).SPR || (ee_addr + (words << 2)) > Ps2MemSize::MainRam ||
+		(iop_addr + (words << 2)) > Ps2MemSize::IopRam)
+	{
+		return;
+	}
+
+	SIF_LOG("Sif1: Bulk transfer %X words from %08X to %08X", words, sif1ch.madr, hw_dma10.madr);
+
+	const u32* from = (const u32*)&eeMem->Main[ee_addr];
+	std::memcpy(&iopMem->Main[iop_addr], from, words << 2);
+	sif1.fifo.passThrough(&from[words - FIFO_SIF_W]);
+
+	sif1ch.madr += words << 2;
+	hwDmacSrcTadrInc(sif1ch);
+	sif1.ee.cycles += words >> 2;
+	sif1ch.qwc -= words >> 2;
+
+	psxCpu->Clear(hw_dma10.madr, words);
+	hw_dma10.madr += words << 2;
+	sif1.iop.cycles += words >> 2;
+	sif1.iop.counter -= words;
+}
+
 // Get a tag and process it.
 static __fi bool ProcessEETag()
 {
@@ -293,6 +332,8 @@ __fi void SIF1Dma()
 		//I realise this is very hacky in a way but its an easy way of checking if both are doing something
 		BusyCheck = 0;
 
+		BulkTransfer();
+
 		if (sif1.ee.busy && !sif1_dma_stall)
 		{
 			if(sif1.fifo.sif_free() > 0 || (sif1.ee.end && sif1ch.qwc == 0))
@@ -34,6 +34,9 @@
 #include "iR5900.h"
 #include "System.h"
 #include "DebugTools/Debug.h"
+#include "Frontend/LogSink.h"
+
+#include "common/StringUtil.h"
 
 #include "fmt/core.h"
 
@@ -48,16 +51,12 @@ SysConsoleLogPack SysConsole;
 // writes text directly to the logfile, no newlines appended.
 void __Log(const char* fmt, ...)
 {
+	if (emuLog == NULL)
+		return;
+
 	va_list list;
 	va_start(list, fmt);
-
-	if (emuLog != NULL)
-	{
-		std::vfprintf(emuLog, fmt, list);
-		fputs("\n", emuLog);
-		fflush(emuLog);
-	}
-
+	CommonHost::WriteTraceLog(StringUtil::StdStringFromFormatV(fmt, list).c_str());
 	va_end(list);
 }
 
@@ -66,9 +65,7 @@ void SysTraceLog::DoWrite(const char* msg) const
 	if (emuLog == NULL)
 		return;
 
-	fputs(msg, emuLog);
-	fputs("\n", emuLog);
-	fflush(emuLog);
+	CommonHost::WriteTraceLog(msg);
 }
 
 void SysTraceLog_EE::ApplyPrefix(std::string& ascii) const
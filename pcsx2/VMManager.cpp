@@ -763,7 +763,7 @@ void VMManager::UpdateRunningGame(bool resetting, bool game_starting)
 
 	Host::OnGameChanged(s_disc_path, s_elf_override, s_game_serial, s_game_name, s_game_crc);
 
-	MIPSAnalyst::ScanForFunctions(R5900SymbolMap, ElfTextRange.first, ElfTextRange.first + ElfTextRange.second, true);
+	MIPSAnalyst::ScanForFunctionsAsync(R5900SymbolMap, ElfTextRange.first, ElfTextRange.first + ElfTextRange.second, ElfCRC);
 	R5900SymbolMap.UpdateActiveSymbols();
 	R3000SymbolMap.UpdateActiveSymbols();
 }
@@ -1099,6 +1099,8 @@ void VMManager::Shutdown(bool save_resume_state)
 		GSDumpReplayer::Shutdown();
 	}
 
+	MIPSAnalyst::CancelFunctionScan();
+
 	{
 		LastELF.clear();
 		DiscSerial.clear();
@@ -1617,6 +1619,9 @@ void VMManager::Internal::VSyncOnCPUThread()
 	ApplyLoadedPatches(PPT_CONTINUOUSLY);
 	ApplyLoadedPatches(PPT_COMBINED_0_1);
 
+	// picks up code the game wrote over since the function scan
+	MIPSAnalyst::RescanInvalidatedFunctions();
+
 	// Frame advance must be done *before* pumping messages, because otherwise
 	// we'll immediately reduce the counter we just set.
 	if (s_frame_advance_count > 0)
@@ -1664,8 +1669,17 @@ void VMManager::CheckForCPUConfigChanges(const Pcsx2Config& old_config)
 	SysClearExecutionCache();
 	memBindConditionalHandlers();
 
-	if (EmuConfig.Cpu.Recompiler.EnableFastmem != old_config.Cpu.Recompiler.EnableFastmem)
+	if (EmuConfig.Cpu.Recompiler.EnableFastmem != old_config.Cpu.Recompiler.EnableFastmem ||
+		EmuConfig.Cpu.Recompiler.EnableEECache != old_config.Cpu.Recompiler.EnableEECache)
+	{
 		vtlb_ResetFastmem();
+	}
+	// cvmap only exists while both the cache and the EE rec are on.
+	if (EmuConfig.Cpu.Recompiler.EnableEECache != old_config.Cpu.Recompiler.EnableEECache ||
+		EmuConfig.Cpu.CpusChanged(old_config.Cpu))
+	{
+		vtlb_UpdateCacheablePages();
+	}
 
 	// did we toggle recompilers?
 	if (EmuConfig.Cpu.CpusChanged(old_config.Cpu))
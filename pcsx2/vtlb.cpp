@@ -66,6 +66,12 @@ static vtlbHandler UnmappedVirtHandler0;
 static vtlbHandler UnmappedVirtHandler1;
 static vtlbHandler UnmappedPhyHandler0;
 static vtlbHandler UnmappedPhyHandler1;
+static vtlbHandler CachedMemHandler;
+
+// One bit per 4k page covered by a TLB entry with the cached attribute (C=3), and the
+// page ranges that set them, so a rebuild only has to revisit those.
+static u32 s_cacheable_pages[VTLB_VMAP_ITEMS / 32];
+static std::vector<std::pair<u32, u32>> s_cacheable_ranges;
 
 struct FastmemVirtualMapping
 {
@@ -96,6 +102,7 @@ static std::vector<u32> s_fastmem_virtual_mapping; // maps vaddr -> mainmem offs
 static std::unordered_multimap<u32, u32> s_fastmem_physical_mapping;	// maps mainmem offset -> vaddr
 static std::unordered_map<uptr, LoadstoreBackpatchInfo> s_fastmem_backpatch_info;
 static std::unordered_set<u32> s_fastmem_faulting_pcs;
+static std::unordered_set<u32> s_fastmem_watched_pages;
 
 vtlb_private::VTLBPhysical vtlb_private::VTLBPhysical::fromPointer(sptr ptr) {
 	pxAssertMsg(ptr >= 0, "Address too high");
@@ -117,37 +124,22 @@ vtlb_private::VTLBVirtual::VTLBVirtual(VTLBPhysical phys, u32 paddr, u32 vaddr)
 	}
 }
 
-__inline int CheckCache(u32 addr)
+static __fi bool vtlb_IsCacheablePage(u32 page)
 {
-	u32 mask;
+	return (s_cacheable_pages[page / 32] >> (page % 32)) & 1;
+}
 
+__inline int CheckCache(u32 addr)
+{
 	if(((cpuRegs.CP0.n.Config >> 16) & 0x1) == 0)
 	{
 		//DevCon.Warning("Data Cache Disabled! %x", cpuRegs.CP0.n.Config);
 		return false;//
 	}
 
-	for(int i = 1; i < 48; i++)
-	{
-		if (((tlb[i].EntryLo1 & 0x38) >> 3) == 0x3) {
-			mask  = tlb[i].PageMask;
-
-			if ((addr >= tlb[i].PFN1) && (addr <= tlb[i].PFN1 + mask)) {
-				//DevCon.Warning("Yay! Cache check cache addr=%x, mask=%x, addr+mask=%x, VPN2=%x PFN0=%x", addr, mask, (addr & mask), tlb[i].VPN2, tlb[i].PFN0);
-				return true;
-			}
-		}
-		if (((tlb[i].EntryLo0 & 0x38) >> 3) == 0x3) {
-			mask  = tlb[i].PageMask;
-
-			if ((addr >= tlb[i].PFN0) && (addr <= tlb[i].PFN0 + mask)) {
-				//DevCon.Warning("Yay! Cache check cache addr=%x, mask=%x, addr+mask=%x, VPN2=%x PFN0=%x", addr, mask, (addr & mask), tlb[i].VPN2, tlb[i].PFN0);
-				return true;
-			}
-		}
-	}
-	return false;
+	return vtlb_IsCacheablePage(addr >> VTLB_PAGE_BITS);
 }
+
 // --------------------------------------------------------------------------------------
 // Interpreter Implementations of VTLB Memory Operations.
 // --------------------------------------------------------------------------------------
@@ -161,27 +153,24 @@ DataType vtlb_memRead(u32 addr)
 
 	if (!vmv.isHandler(addr))
 	{
-		if (!CHECK_EEREC)
+		if(CHECK_CACHE && CheckCache(addr))
 		{
-			if(CHECK_CACHE && CheckCache(addr))
+			switch( DataSize )
 			{
-				switch( DataSize )
-				{
-					case 8:
-						return readCache8(addr);
-						break;
-					case 16:
-						return readCache16(addr);
-						break;
-					case 32:
-						return readCache32(addr);
-						break;
-					case 64:
-						return readCache64(addr);
-						break;
-
-					jNO_DEFAULT;
-				}
+				case 8:
+					return readCache8(addr);
+					break;
+				case 16:
+					return readCache16(addr);
+					break;
+				case 32:
+					return readCache32(addr);
+					break;
+				case 64:
+					return readCache64(addr);
+					break;
+
+				jNO_DEFAULT;
 			}
 		}
 
@@ -216,12 +205,9 @@ RETURNS_R128 vtlb_memRead128(u32 mem)
 
 	if (!vmv.isHandler(mem))
 	{
-		if (!CHECK_EEREC)
+		if(CHECK_CACHE && CheckCache(mem))
 		{
-			if(CHECK_CACHE && CheckCache(mem))
-			{
-				return readCache128(mem);
-			}
+			return readCache128(mem);
 		}
 
 		return r128_load(reinterpret_cast<const void*>(vmv.assumePtr(mem)));
@@ -244,25 +230,22 @@ void vtlb_memWrite(u32 addr, DataType data)
 
 	if (!vmv.isHandler(addr))
 	{
-		if (!CHECK_EEREC)
+		if(CHECK_CACHE && CheckCache(addr))
 		{
-			if(CHECK_CACHE && CheckCache(addr))
+			switch( DataSize )
 			{
-				switch( DataSize )
-				{
-				case 8:
-					writeCache8(addr, data);
-					return;
-				case 16:
-					writeCache16(addr, data);
-					return;
-				case 32:
-					writeCache32(addr, data);
-					return;
-				case 64:
-					writeCache64(addr, data);
-					return;
-				}
+			case 8:
+				writeCache8(addr, data);
+				return;
+			case 16:
+				writeCache16(addr, data);
+				return;
+			case 32:
+				writeCache32(addr, data);
+				return;
+			case 64:
+				writeCache64(addr, data);
+				return;
 			}
 		}
 
@@ -283,14 +266,11 @@ void TAKES_R128 vtlb_memWrite128(u32 mem, r128 value)
 
 	if (!vmv.isHandler(mem))
 	{
-		if (!CHECK_EEREC)
+		if(CHECK_CACHE && CheckCache(mem))
 		{
-			if(CHECK_CACHE && CheckCache(mem))
-			{
-				alignas(16) const u128 r = r128_to_u128(value);
-				writeCache128(mem, &r);
-				return;
-			}
+			alignas(16) const u128 r = r128_to_u128(value);
+			writeCache128(mem, &r);
+			return;
 		}
 
 		r128_store_unaligned((void*)vmv.assumePtr(mem), value);
@@ -881,6 +861,19 @@ static void vtlb_RemoveFastmemMapping(u32 vaddr)
 	}
 }
 
+// Recreates the fastmem mapping for a page from its current virtual mapping.
+static void vtlb_RestoreFastmemMapping(u32 vaddr)
+{
+	const VTLBVirtual vmv = vtlbdata.vmap[vaddr >> VTLB_PAGE_BITS];
+	if (vmv.isHandler(vaddr))
+		return;
+
+	u32 mainmem_offset, mainmem_size;
+	PageProtectionMode mode;
+	if (vtlb_GetMainMemoryOffsetFromPtr(vmv.assumePtr(vaddr), &mainmem_offset, &mainmem_size, &mode))
+		vtlb_CreateFastmemMapping(vaddr, mainmem_offset, mode);
+}
+
 static void vtlb_RemoveFastmemMappings(u32 vaddr, u32 size)
 {
 	pxAssert((vaddr & VTLB_PAGE_MASK) == 0);
@@ -1017,6 +1010,10 @@ bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address)
 		info.gpr_bitmask, info.fpr_bitmask, info.address_register, info.data_register,
 		info.size_in_bits, info.is_signed, info.is_load, info.is_fpr);
 
+	// let the recompiler instrument accesses to watched memory
+	if (vtlb_IsWatchedAddress(guest_addr))
+		vtlb_DynWatchedLoadStore(info.guest_pc, guest_addr, info.size_in_bits, info.is_load);
+
 	// queue block for recompilation later
 	Cpu->Clear(info.guest_pc, 1);
 
@@ -1031,8 +1028,46 @@ bool vtlb_IsFaultingPC(u32 guest_pc)
 	return (s_fastmem_faulting_pcs.find(guest_pc) != s_fastmem_faulting_pcs.end());
 }
 
+void vtlb_SetWatchedPages(const std::vector<u32>& vpages)
+{
+	std::unordered_set<u32> old_pages(std::move(s_fastmem_watched_pages));
+	s_fastmem_watched_pages.clear();
+	s_fastmem_watched_pages.insert(vpages.begin(), vpages.end());
+
+	if (!CHECK_FASTMEM || s_fastmem_virtual_mapping.empty())
+		return;
+
+	for (const u32 page : old_pages)
+	{
+		if (s_fastmem_watched_pages.find(page) == s_fastmem_watched_pages.end())
+			vtlb_RestoreFastmemMapping(page << VTLB_PAGE_BITS);
+	}
+
+	for (const u32 page : s_fastmem_watched_pages)
+		vtlb_RemoveFastmemMapping(page << VTLB_PAGE_BITS);
+}
+
+bool vtlb_IsWatchedAddress(u32 vaddr)
+{
+	return (!s_fastmem_watched_pages.empty() &&
+			s_fastmem_watched_pages.find(vaddr >> VTLB_PAGE_BITS) != s_fastmem_watched_pages.end());
+}
+
 //virtual mappings
 //TODO: Add invalid paddr checks
+// The recompilers look pages up in cvmap instead of vmap while EE cache emulation is on. It
+// matches vmap, except that cacheable RAM pages go to CachedMemHandler, which is registered
+// with the interpreter accessors and so gets the virtual address and goes through the cache.
+static void vtlb_UpdateCachedVirtual(u32 page)
+{
+	const u32 vaddr = page << VTLB_PAGE_BITS;
+	const VTLBVirtual vmv = vtlbdata.vmap[page];
+	if (vtlb_IsCacheablePage(page) && !vmv.isHandler(vaddr))
+		vtlbdata.cvmap[page] = VTLBVirtual(VTLBPhysical::fromHandler(CachedMemHandler), vaddr, vaddr);
+	else
+		vtlbdata.cvmap[page] = vmv;
+}
+
 void vtlb_VMap(u32 vaddr,u32 paddr,u32 size)
 {
 	verify(0==(vaddr&VTLB_PAGE_MASK));
@@ -1049,7 +1084,7 @@ void vtlb_VMap(u32 vaddr,u32 paddr,u32 size)
 		{
 			u32 hoffset, hsize;
 			PageProtectionMode mode;
-			if (vtlb_GetMainMemoryOffset(current_paddr, &hoffset, &hsize, &mode))
+			if (!vtlb_IsWatchedAddress(current_vaddr) && vtlb_GetMainMemoryOffset(current_paddr, &hoffset, &hsize, &mode))
 				vtlb_CreateFastmemMapping(current_vaddr, hoffset, mode);
 			else
 				vtlb_RemoveFastmemMapping(current_vaddr);
@@ -1070,6 +1105,8 @@ void vtlb_VMap(u32 vaddr,u32 paddr,u32 size)
 		}
 
 		vtlbdata.vmap[vaddr>>VTLB_PAGE_BITS] = vmv;
+		if (vtlbdata.cvmap)
+			vtlb_UpdateCachedVirtual(vaddr>>VTLB_PAGE_BITS);
 		if (vtlbdata.ppmap)
 			if (!(vaddr & 0x80000000)) // those address are already physical don't change them
 				vtlbdata.ppmap[vaddr>>VTLB_PAGE_BITS] = paddr & ~VTLB_PAGE_MASK;
@@ -1093,7 +1130,12 @@ void vtlb_VMapBuffer(u32 vaddr,void* buffer,u32 size)
 			u32 fm_hostoffset = HostMemoryMap::EEmemOffset + offsetof(EEVM_MemoryAllocMess, Scratch);
 			PageProtectionMode mode = PageProtectionMode().Read().Write();
 			for (u32 i = 0; i < (Ps2MemSize::Scratch / VTLB_PAGE_SIZE); i++, fm_vaddr += VTLB_PAGE_SIZE, fm_hostoffset += VTLB_PAGE_SIZE)
-				vtlb_CreateFastmemMapping(fm_vaddr, fm_hostoffset, mode);
+			{
+				if (!vtlb_IsWatchedAddress(fm_vaddr))
+					vtlb_CreateFastmemMapping(fm_vaddr, fm_hostoffset, mode);
+				else
+					vtlb_RemoveFastmemMapping(fm_vaddr);
+			}
 		}
 		else
 		{
@@ -1105,6 +1147,8 @@ void vtlb_VMapBuffer(u32 vaddr,void* buffer,u32 size)
 	while (size > 0)
 	{
 		vtlbdata.vmap[vaddr>>VTLB_PAGE_BITS] = VTLBVirtual::fromPointer(bu8, vaddr);
+		if (vtlbdata.cvmap)
+			vtlb_UpdateCachedVirtual(vaddr>>VTLB_PAGE_BITS);
 		vaddr += VTLB_PAGE_SIZE;
 		bu8 += VTLB_PAGE_SIZE;
 		size -= VTLB_PAGE_SIZE;
@@ -1129,6 +1173,8 @@ void vtlb_VMapUnmap(u32 vaddr,u32 size)
 		}
 
 		vtlbdata.vmap[vaddr>>VTLB_PAGE_BITS] = handl;
+		if (vtlbdata.cvmap)
+			vtlb_UpdateCachedVirtual(vaddr>>VTLB_PAGE_BITS);
 		vaddr += VTLB_PAGE_SIZE;
 		size -= VTLB_PAGE_SIZE;
 	}
@@ -1160,6 +1206,10 @@ void vtlb_Init()
 
 	DefaultPhyHandler = vtlb_RegisterHandler(0,0,0,0,0,0,0,0,0,0);
 
+	CachedMemHandler = vtlb_RegisterHandler(
+		vtlb_memRead<mem8_t>, vtlb_memRead<mem16_t>, vtlb_memRead<mem32_t>, vtlb_memRead<mem64_t>, vtlb_memRead128,
+		vtlb_memWrite<mem8_t>, vtlb_memWrite<mem16_t>, vtlb_memWrite<mem32_t>, vtlb_memWrite<mem64_t>, vtlb_memWrite128);
+
 	//done !
 
 	//Setup the initial mappings
@@ -1174,6 +1224,8 @@ void vtlb_Init()
 	if (EmuConfig.Gamefixes.GoemonTlbHack)
 		vtlb_Alloc_Ppmap();
 
+	vtlb_UpdateCacheablePages();
+
 	extern void vtlb_dynarec_init();
 	vtlb_dynarec_init();
 }
@@ -1184,6 +1236,7 @@ void vtlb_Reset()
 {
 	vtlb_RemoveFastmemMappings();
 	for(int i=0; i<48; i++) UnmapTLB(tlb[i], i);
+	vtlb_UpdateCacheablePages();
 }
 
 void vtlb_Shutdown()
@@ -1282,6 +1335,76 @@ void vtlb_Alloc_Ppmap()
 		vtlbdata.ppmap[i] = i<<VTLB_PAGE_BITS;
 }
 
+static constexpr size_t CVMAP_SIZE = sizeof(*vtlbdata.cvmap) * VTLB_VMAP_ITEMS;
+
+// Rebuilds the set of cacheable pages from the TLB entries with the cached attribute, and
+// allocates or drops cvmap depending on whether the EE rec needs it. Each such entry covers
+// the Mask+1 pages starting at its PFN, the same pages MapTLB() maps for it. The old scan in
+// CheckCache() compared against PFN+PageMask in bytes instead, which isn't the entry's size.
+void vtlb_UpdateCacheablePages()
+{
+	const std::vector<std::pair<u32, u32>> old_ranges = std::move(s_cacheable_ranges);
+	s_cacheable_ranges.clear();
+	for (const auto& [first, last] : old_ranges)
+	{
+		for (u32 page = first; page <= last; page++)
+			s_cacheable_pages[page / 32] &= ~(1u << (page % 32));
+	}
+
+	const auto add_range = [](u32 entrylo, u32 pfn, u32 mask) {
+		if (((entrylo & 0x38) >> 3) != 0x3)
+			return;
+
+		const u32 first = pfn >> VTLB_PAGE_BITS;
+		const u32 last = std::min<u32>(first + mask, VTLB_VMAP_ITEMS - 1);
+		for (u32 page = first; page <= last; page++)
+			s_cacheable_pages[page / 32] |= 1u << (page % 32);
+		s_cacheable_ranges.emplace_back(first, last);
+	};
+	for (int i = 1; i < 48; i++)
+	{
+		add_range(tlb[i].EntryLo1, tlb[i].PFN1, tlb[i].Mask);
+		add_range(tlb[i].EntryLo0, tlb[i].PFN0, tlb[i].Mask);
+	}
+
+	if (!CHECK_CACHE || !CHECK_EEREC || !vtlbdata.vmap)
+	{
+		if (vtlbdata.cvmap)
+		{
+			HostSys::MemProtect(vtlbdata.cvmap, CVMAP_SIZE, PageProtectionMode());
+			vtlbdata.cvmap = nullptr;
+		}
+		return;
+	}
+
+	if (!vtlbdata.cvmap)
+	{
+		static VTLBVirtual* cvmap = nullptr;
+		if (!cvmap)
+		{
+			cvmap = (VTLBVirtual*)GetVmMemory().BumpAllocator().Alloc(CVMAP_SIZE);
+			if (!cvmap)
+				pxFailRel("Failed to allocate vtlb cvmap");
+		}
+
+		HostSys::MemProtect(cvmap, CVMAP_SIZE, PageProtectionMode().Read().Write());
+		vtlbdata.cvmap = cvmap;
+		for (u32 page = 0; page < VTLB_VMAP_ITEMS; page++)
+			vtlb_UpdateCachedVirtual(page);
+		return;
+	}
+
+	const auto refresh = [](const std::vector<std::pair<u32, u32>>& ranges) {
+		for (const auto& [first, last] : ranges)
+		{
+			for (u32 page = first; page <= last; page++)
+				vtlb_UpdateCachedVirtual(page);
+		}
+	};
+	refresh(old_ranges);
+	refresh(s_cacheable_ranges);
+}
+
 void vtlb_Core_Free()
 {
 	if (vtlbdata.vmap)
@@ -1294,6 +1417,11 @@ void vtlb_Core_Free()
 		HostSys::MemProtect(vtlbdata.ppmap, PPMAP_SIZE, PageProtectionMode());
 		vtlbdata.ppmap = nullptr;
 	}
+	if (vtlbdata.cvmap)
+	{
+		HostSys::MemProtect(vtlbdata.cvmap, CVMAP_SIZE, PageProtectionMode());
+		vtlbdata.cvmap = nullptr;
+	}
 
 	vtlb_RemoveFastmemMappings();
 	vtlb_ClearLoadStoreInfo();
@@ -20,6 +20,8 @@
 
 #include "common/PageFaultSource.h"
 
+#include <vector>
+
 static const uptr VTLB_AllocUpperBounds = _1gb * 2;
 
 // Specialized function pointers for each read type
@@ -54,6 +56,7 @@ typedef u32 vtlbHandler;
 extern void vtlb_Core_Alloc();
 extern void vtlb_Core_Free();
 extern void vtlb_Alloc_Ppmap();
+extern void vtlb_UpdateCacheablePages();
 extern void vtlb_Init();
 extern void vtlb_Shutdown();
 extern void vtlb_Reset();
@@ -88,11 +91,18 @@ extern bool vtlb_GetGuestAddress(uptr host_addr, u32* guest_addr);
 extern void vtlb_UpdateFastmemProtection(u32 paddr, u32 size, const PageProtectionMode& prot);
 extern bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address);
 
+// Watched pages are left out of the fastmem area, so every fastmem access to them faults.
+extern void vtlb_SetWatchedPages(const std::vector<u32>& vpages);
+extern bool vtlb_IsWatchedAddress(u32 vaddr);
+
 extern void vtlb_ClearLoadStoreInfo();
 extern void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
 extern void vtlb_DynBackpatchLoadStore(uptr code_address, u32 code_size, u32 guest_pc, u32 guest_addr, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
 extern bool vtlb_IsFaultingPC(u32 guest_pc);
 
+// Implemented by the EE recompiler, called when a fastmem access to a watched page is backpatched.
+extern void vtlb_DynWatchedLoadStore(u32 guest_pc, u32 guest_addr, u32 size_in_bits, bool is_load);
+
 //Memory functions
 
 template< typename DataType >
@@ -264,12 +274,15 @@ namespace vtlb_private
 
 		u32* ppmap;               //4MB (allocated by vtlb_init) // PS2 virtual to PS2 physical
 
+		VTLBVirtual* cvmap;       //4MB (allocated when EE cache emulation is used with the EE rec) // vmap, with cached pages sent to the cache handler
+
 		uptr fastmem_base;
 
 		MapData()
 		{
 			vmap = NULL;
 			ppmap = NULL;
+			cvmap = NULL;
 			fastmem_base = 0;
 		}
 	};
@@ -30,6 +30,8 @@
 #include "Common.h"
 #include "VMManager.h"
 
+#include "common/PerfTrace.h"
+
 #include <time.h>
 
 #ifndef _WIN32
@@ -1553,6 +1555,8 @@ static void PreBlockCheck(u32 blockpc)
 
 static void iopRecRecompile(const u32 startpc)
 {
+	PERF_TRACE_ZONE("IOP", "Recompile");
+
 	u32 i;
 	u32 willbranch3 = 0;
 
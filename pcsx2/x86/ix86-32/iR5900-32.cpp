@@ -34,12 +34,16 @@
 #include "Elfheader.h"
 
 #include "DebugTools/Breakpoints.h"
+#include "DebugTools/MIPSAnalyst.h"
 #include "Patch.h"
 
 #include "common/AlignedMalloc.h"
 #include "common/FastJmp.h"
 #include "common/MemsetFast.inl"
 #include "common/Perf.h"
+#include "common/PerfTrace.h"
+
+#include <unordered_set>
 
 // Only for MOVQ workaround.
 #include "common/emitter/internal.h"
@@ -110,6 +114,7 @@ static BASEBLOCKEX* s_pCurBlockEx = NULL;
 u32 s_nEndBlock = 0; // what pc the current block ends
 u32 s_branchTo;
 static bool s_nBlockFF;
+static bool s_nBlockRestart = false; // block has to end earlier than the scan decided, compile it again
 
 // save states for branches
 GPR_reg64 s_saveConstRegs[32];
@@ -381,6 +386,10 @@ static DynGenFunc* ExitRecompiledCode = NULL;
 static DynGenFunc* DispatchBlockDiscard = NULL;
 static DynGenFunc* DispatchPageReset = NULL;
 
+static void recUpdateMemcheckWatches();
+static void recHandleMemcheckFault();
+static u32 s_memcheck_fault_result = 0;
+
 static void recEventTest()
 {
 	_cpuEventTest_Shared();
@@ -390,6 +399,9 @@ static void recEventTest()
 		eeRecExitRequested = false;
 		recExitExecution();
 	}
+
+	if (s_memcheck_fault_result != 0)
+		recHandleMemcheckFault();
 }
 
 // The address for all cleared blocks.  It recompiles the current pc and then
@@ -641,6 +653,7 @@ static void recResetRaw()
 	recBlocks.Reset();
 	mmap_ResetBlockTracking();
 	vtlb_ClearLoadStoreInfo();
+	recUpdateMemcheckWatches();
 
 	x86SetPtr(*recMem);
 
@@ -776,6 +789,9 @@ void recClear(u32 addr, u32 size)
 		return;
 	addr = HWADDR(addr);
 
+	// the debugger's function scan uses the same write tracking to know what to look at again
+	MIPSAnalyst::InvalidateScannedCode(addr, size);
+
 	int blockidx = recBlocks.LastIndex(addr + size * 4 - 4);
 
 	if (blockidx == -1)
@@ -1595,6 +1611,109 @@ void dynarecMemLogcheck(u32 start, bool store)
 		DevCon.WriteLn("Hit load breakpoint @0x%x", start);
 }
 
+// With fastmem, memory instructions only get a memcheck once they're known to touch watched memory.
+// Watched pages are left out of the fastmem area, so the first access faults, gets backpatched to
+// slowmem, and the block is recompiled with the instruction split out and checked like before.
+static std::unordered_set<u32> s_memcheck_pcs;
+static u32 s_memcheck_fault_addr = 0;
+static bool s_memcheck_fault_store = false;
+
+static u32 recGetMemcheckResult(u32 addr, u32 bits, bool store)
+{
+	const u32 start = standardizeBreakpointAddress(addr);
+	const u32 end = start + bits / 8;
+	u32 result = 0;
+
+	for (const MemCheck& check : CBreakPoints::GetMemChecks(BREAKPOINT_EE))
+	{
+		if (check.result == 0)
+			continue;
+		if ((check.cond & MEMCHECK_WRITE) == 0 && store)
+			continue;
+		if ((check.cond & MEMCHECK_READ) == 0 && !store)
+			continue;
+
+		if (start < standardizeBreakpointAddress(check.end) && standardizeBreakpointAddress(check.start) < end)
+			result |= check.result;
+	}
+
+	return result;
+}
+
+static void recUpdateMemcheckWatches()
+{
+	s_memcheck_pcs.clear();
+	s_memcheck_fault_result = 0;
+
+	std::vector<u32> pages;
+	if (CHECK_FASTMEM)
+	{
+		for (const MemCheck& check : CBreakPoints::GetMemChecks(BREAKPOINT_EE))
+		{
+			const u32 start = standardizeBreakpointAddress(check.start);
+			const u32 end = standardizeBreakpointAddress(check.end);
+			if (check.result == 0 || end <= start)
+				continue;
+
+			// Watch every segment/mirror which standardizes onto the watched range.
+			for (u32 page = start >> vtlb_private::VTLB_PAGE_BITS; page <= ((end - 1) >> vtlb_private::VTLB_PAGE_BITS); page++)
+			{
+				for (u32 segment = 0; segment < 16; segment++)
+				{
+					const u32 vaddr = (segment << 28) | ((page << vtlb_private::VTLB_PAGE_BITS) & 0x0FFFFFFF);
+					if ((standardizeBreakpointAddress(vaddr) >> vtlb_private::VTLB_PAGE_BITS) == page)
+						pages.push_back(vaddr >> vtlb_private::VTLB_PAGE_BITS);
+				}
+			}
+		}
+	}
+
+	vtlb_SetWatchedPages(pages);
+}
+
+static int recIsMemcheckNeeded(u32 pc)
+{
+	const int needed = isMemcheckNeeded(pc);
+	if (needed == 0 || !CHECK_FASTMEM)
+		return needed;
+
+	// Slowmem accesses can't fault, so those still need checking.
+	const u32 addr = (needed == 2) ? (pc + 4) : pc;
+	return (s_memcheck_pcs.find(addr) != s_memcheck_pcs.end() || vtlb_IsFaultingPC(addr)) ? needed : 0;
+}
+
+void vtlb_DynWatchedLoadStore(u32 guest_pc, u32 guest_addr, u32 size_in_bits, bool is_load)
+{
+	s_memcheck_pcs.insert(guest_pc);
+
+	// This access goes through before the instruction is instrumented, so all we can do is report
+	// it at the next event test, which we pull in.
+	const u32 result = recGetMemcheckResult(guest_addr, size_in_bits, !is_load);
+	if (result != 0 && s_memcheck_fault_result == 0)
+	{
+		s_memcheck_fault_addr = guest_addr;
+		s_memcheck_fault_store = !is_load;
+		s_memcheck_fault_result = result;
+		cpuRegs.nextEventCycle = cpuRegs.cycle;
+	}
+}
+
+static void recHandleMemcheckFault()
+{
+	const u32 result = s_memcheck_fault_result;
+	s_memcheck_fault_result = 0;
+
+	if (result & MEMCHECK_LOG)
+		dynarecMemLogcheck(s_memcheck_fault_addr, s_memcheck_fault_store);
+
+	if (result & MEMCHECK_BREAK)
+	{
+		CBreakPoints::SetBreakpointTriggered(true);
+		VMManager::SetPaused(true);
+		recExitExecution();
+	}
+}
+
 void recMemcheck(u32 op, u32 bits, bool store)
 {
 	iFlushCall(FLUSH_EVERYTHING | FLUSH_PC);
@@ -1659,41 +1778,81 @@ void encodeBreakpoint()
 	}
 }
 
-void encodeMemcheck()
+static u32 getMemcheckBits(const OPCODE& opcode)
 {
-	int needed = isMemcheckNeeded(pc);
-	if (needed == 0)
-		return;
-
-	u32 op = memRead32(needed == 2 ? pc + 4 : pc);
-	const OPCODE& opcode = GetInstruction(op);
-
-	bool store = (opcode.flags & IS_STORE) != 0;
 	switch (opcode.flags & MEMTYPE_MASK)
 	{
 		case MEMTYPE_BYTE:
-			recMemcheck(op, 8, store);
-			break;
+			return 8;
 		case MEMTYPE_HALF:
-			recMemcheck(op, 16, store);
-			break;
+			return 16;
 		case MEMTYPE_WORD:
-			recMemcheck(op, 32, store);
-			break;
+			return 32;
 		case MEMTYPE_DWORD:
-			recMemcheck(op, 64, store);
-			break;
+			return 64;
 		case MEMTYPE_QWORD:
-			recMemcheck(op, 128, store);
-			break;
+			return 128;
+		default:
+			return 0;
 	}
 }
 
+// Constant addresses are accessed directly rather than through fastmem, so they never fault.
+// Check them at compile time instead, against the constants known before the instruction at pc.
+static bool recIsConstMemcheckHit()
+{
+	if (!CHECK_FASTMEM || isMemcheckNeeded(pc) != 1)
+		return false;
+
+	const u32 op = memRead32(pc);
+	const OPCODE& opcode = GetInstruction(op);
+	const u32 bits = getMemcheckBits(opcode);
+	const int rs = (op >> 21) & 0x1F;
+	if (bits == 0 || !GPR_IS_CONST1(rs))
+		return false;
+
+	u32 addr = g_cpuConstRegs[rs].UL[0] + (s16)op;
+	if (bits == 128)
+		addr &= ~0x0F;
+
+	return (recGetMemcheckResult(addr, bits, (opcode.flags & IS_STORE) != 0) != 0);
+}
+
+void encodeMemcheck()
+{
+	int needed = recIsMemcheckNeeded(pc);
+	if (needed == 0)
+	{
+		// Only reached at the start of a block, recompileNextInstruction() splits the others off.
+		if (!recIsConstMemcheckHit())
+			return;
+
+		needed = 1;
+	}
+
+	u32 op = memRead32(needed == 2 ? pc + 4 : pc);
+	const OPCODE& opcode = GetInstruction(op);
+	const u32 bits = getMemcheckBits(opcode);
+	if (bits != 0)
+		recMemcheck(op, bits, (opcode.flags & IS_STORE) != 0);
+}
+
 void recompileNextInstruction(bool delayslot, bool swapped_delay_slot)
 {
 	u32 i;
 	int count;
 
+	// End the block before an instruction which hits a memcheck through a constant address, so the
+	// cycles of everything before it are counted. The register liveness was worked out for the whole
+	// block, so it's thrown away and compiled again, and the scan then stops before this instruction.
+	if (!delayslot && HWADDR(pc) != s_pCurBlockEx->startpc && pc < s_nEndBlock && recIsConstMemcheckHit())
+	{
+		s_memcheck_pcs.insert(pc);
+		s_nBlockRestart = true;
+		s_nEndBlock = pc;
+		return;
+	}
+
 	if (EmuConfig.EnablePatches)
 		ApplyDynamicPatches(pc);
 
@@ -2163,6 +2322,8 @@ bool skipMPEG_By_Pattern(u32 sPC)
 
 static void recRecompile(const u32 startpc)
 {
+	PERF_TRACE_ZONE("EE", "Recompile");
+
 	u32 i = 0;
 	u32 willbranch3 = 0;
 
@@ -2231,6 +2392,12 @@ static void recRecompile(const u32 startpc)
 		VMManager::Internal::EntryPointCompilingOnCPUThread();
 	}
 
+	// nothing before this point depends on where the block ends
+	u8* const recompile_ptr = x86Ptr;
+
+RestartRecomp:
+	xSetPtr(recompile_ptr);
+	willbranch3 = 0;
 	g_branch = 0;
 
 	// reset recomp state variables
@@ -2270,7 +2437,7 @@ static void recRecompile(const u32 startpc)
 
 	// compile breakpoints as individual blocks
 	int n1 = isBreakpointNeeded(i);
-	int n2 = isMemcheckNeeded(i);
+	int n2 = recIsMemcheckNeeded(i);
 	int n = std::max<int>(n1, n2);
 	if (n != 0)
 	{
@@ -2283,7 +2450,7 @@ static void recRecompile(const u32 startpc)
 		BASEBLOCK* pblock = PC_GETBLOCK(i);
 
 		// stop before breakpoints
-		if (isBreakpointNeeded(i) != 0 || isMemcheckNeeded(i) != 0)
+		if (isBreakpointNeeded(i) != 0 || recIsMemcheckNeeded(i) != 0)
 		{
 			s_nEndBlock = i;
 			break;
@@ -2585,6 +2752,12 @@ StartRecomp:
 			recompileNextInstruction(false, false); // For the love of recursion, batman!
 #endif
 		}
+
+		if (s_nBlockRestart)
+		{
+			s_nBlockRestart = false;
+			goto RestartRecomp;
+		}
 	}
 
 	pxAssert((pc - startpc) >> 2 <= 0xffff);
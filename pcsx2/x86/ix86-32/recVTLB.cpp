@@ -133,6 +133,14 @@ static void __vectorcall LogWriteQuad(u32 addr, __m128i val)
 
 namespace vtlb_private
 {
+	// ------------------------------------------------------------------------
+	// With EE cache emulation on, cacheable pages are handlers in cvmap, so the usual
+	// handler test sends them through the cache and everything else stays direct.
+	static VTLBVirtual* GetRecVirtualMap()
+	{
+		return vtlbdata.cvmap ? vtlbdata.cvmap : vtlbdata.vmap;
+	}
+
 	// ------------------------------------------------------------------------
 	// Prepares eax, ecx, and, ebx for Direct or Indirect operations.
 	// Returns the writeback pointer for ebx (return address from indirect handling)
@@ -168,7 +176,7 @@ namespace vtlb_private
 
 		xMOV(eax, arg1regd);
 		xSHR(eax, VTLB_PAGE_BITS);
-		xMOV(rax, ptrNative[xComplexAddress(arg3reg, vtlbdata.vmap, rax * wordsize)]);
+		xMOV(rax, ptrNative[xComplexAddress(arg3reg, GetRecVirtualMap(), rax * wordsize)]);
 		xADD(arg1reg, rax);
 	}
 
@@ -485,7 +493,7 @@ int vtlb_DynGenReadNonQuad_Const(u32 bits, bool sign, bool xmm, u32 addr_const,
 	EE::Profiler.EmitConstMem(addr_const);
 
 	int x86_dest_reg;
-	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
+	auto vmv = GetRecVirtualMap()[addr_const >> VTLB_PAGE_BITS];
 	if (!vmv.isHandler(addr_const))
 	{
 		auto ppf = vmv.assumePtr(addr_const);
@@ -632,7 +640,7 @@ int vtlb_DynGenReadQuad_Const(u32 bits, u32 addr_const, vtlb_ReadRegAllocCallbac
 	EE::Profiler.EmitConstMem(addr_const);
 
 	int reg;
-	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
+	auto vmv = GetRecVirtualMap()[addr_const >> VTLB_PAGE_BITS];
 	if (!vmv.isHandler(addr_const))
 	{
 		void* ppf = reinterpret_cast<void*>(vmv.assumePtr(addr_const));
@@ -836,7 +844,7 @@ void vtlb_DynGenWrite_Const(u32 bits, bool xmm, u32 addr_const, int value_reg)
 	}
 #endif
 
-	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
+	auto vmv = GetRecVirtualMap()[addr_const >> VTLB_PAGE_BITS];
 	if (!vmv.isHandler(addr_const))
 	{
 		auto ppf = vmv.assumePtr(addr_const);
@@ -36,6 +36,7 @@ using namespace x86Emitter;
 #include "microVU_IR.h"
 #include "microVU_Profiler.h"
 #include "common/Perf.h"
+#include "common/PerfTrace.h"
 
 struct microBlockLink
 {
@@ -699,6 +699,8 @@ static void mvuPreloadRegisters(microVU& mVU, u32 endCount)
 
 void* mVUcompile(microVU& mVU, u32 startPC, uptr pState)
 {
+	PERF_TRACE_ZONE("VU", mVU.index ? "VU1 Recompile" : "VU0 Recompile");
+
 	microFlagCycles mFC;
 	u8* thisPtr = x86Ptr;
 	const u32 endCount = (((microRegInfo*)pState)->blockType) ? 1 : (mVU.microMemSize / 8);
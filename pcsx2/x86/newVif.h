@@ -40,6 +40,16 @@ extern void  VifUnpackSSE_Destroy();
 
 _vifT extern void dVifUnpack(const u8* data, bool isFill);
 
+// Totals of the unpack block cache counters over both VIFs.
+struct nVifCacheCounters
+{
+	u64 hits;
+	u64 misses;
+	u64 probes;
+	u64 compiles;
+};
+extern nVifCacheCounters dVifGetCacheCounters();
+
 #define VUFT VIFUnpackFuncTable
 #define _v0 0
 #define _v1 0x55
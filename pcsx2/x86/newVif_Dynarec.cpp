@@ -24,6 +24,8 @@
 #include "common/StringUtil.h"
 #include "fmt/core.h"
 
+_vifT static void dVifPrecompile();
+
 static void recReset(int idx)
 {
 	nVif[idx].vifBlocks.reset();
@@ -48,6 +50,28 @@ void dVifReset(int idx)
 	pxAssertDev(nVif[idx].recReserve, "Dynamic VIF recompiler reserve must be created prior to VIF use or reset!");
 
 	recReset(idx);
+
+	if (EmuConfig.Cpu.Recompiler.PrecompileVIFUnpacks)
+	{
+		if (idx)
+			dVifPrecompile<1>();
+		else
+			dVifPrecompile<0>();
+	}
+}
+
+nVifCacheCounters dVifGetCacheCounters()
+{
+	nVifCacheCounters counters = {};
+	for (const nVifStruct& v : nVif)
+	{
+		const nVifCacheStats& stats = v.vifBlocks.stats();
+		counters.hits += stats.hits.load(std::memory_order_relaxed);
+		counters.misses += stats.misses.load(std::memory_order_relaxed);
+		counters.probes += stats.probes.load(std::memory_order_relaxed);
+		counters.compiles += stats.compiles.load(std::memory_order_relaxed);
+	}
+	return counters;
 }
 
 void dVifClose(int idx)
@@ -367,37 +391,76 @@ _vifT __fi nVifBlock* dVifCompile(nVifBlock& block, bool isFill)
 	return &block;
 }
 
-_vifT __fi void dVifUnpack(const u8* data, bool isFill)
+static __fi void dVifMakeKey(nVifBlock& block, u32 upkType, u32 num, u32 mask, u32 mode, u32 aligned, u32 cl, u32 wl)
 {
-
-	nVifStruct&   v       = nVif[idx];
-	vifStruct&    vif     = MTVU_VifX;
-	VIFregisters& vifRegs = MTVU_VifXRegs;
-
-	const u8  upkType = (vif.cmd & 0x1f) | (vif.usn << 5);
-	const int doMask  = isFill ? 1 : (vif.cmd & 0x10);
-
-	nVifBlock block;
-
 	// Performance note: initial code was using u8/u16 field of the struct
 	// directly. However reading back the data (as u32) in HashBucket.find
 	// leads to various memory stalls. So it is way faster to manually build the data
 	// in u32 (aka x86 register).
 	//
 	// Warning the order of data in hash_key/key0/key1 depends on the nVifBlock struct
-	u32 hash_key = (u32)(upkType & 0xFF) << 8 | (vifRegs.num & 0xFF);
+	const u32 hash_key = (upkType & 0xFF) << 8 | (num & 0xFF);
 
-	u32 key1 = ((u32)vifRegs.cycle.wl << 24) | ((u32)vifRegs.cycle.cl << 16) | ((u32)(vif.start_aligned & 0xFF) << 8) | ((u32)vifRegs.mode & 0xFF);
+	u32 key1 = ((wl & 0xFF) << 24) | ((cl & 0xFF) << 16) | ((aligned & 0xFF) << 8) | (mode & 0xFF);
 	if ((upkType & 0xf) != 9)
 		key1 &= 0xFFFF01FF;
 
-	// Zero out the mask parameter if it's unused -- games leave random junk
+	// The caller zeroes the mask if it's unused -- games leave random junk
 	// values here which cause false recblock cache misses.
-	u32 key0 = doMask ? vifRegs.mask : 0;
-
 	block.hash_key = hash_key;
-	block.key0 = key0;
+	block.key0 = mask;
 	block.key1 = key1;
+}
+
+// Compiles the unpack shapes games use most (plain, unmasked, cl == wl == 1 unpacks of the
+// common formats) up front, so the first frames of a game don't stall on recompilation.
+_vifT static void dVifPrecompile()
+{
+	static constexpr u8 upkTypes[] = {
+		0x0, // S-32
+		0x4, // V2-32
+		0x8, // V3-32
+		0xC, // V4-32
+		0xD, // V4-16
+		0xE, // V4-8
+		0xF, // V4-5
+	};
+	static constexpr u8 nums[] = {1, 2, 4, 8, 16, 32, 64, 128, 0 /* 256 */};
+
+	nVifStruct& v = nVif[idx];
+	const u32 before = v.vifBlocks.size();
+
+	for (u8 upkType : upkTypes)
+	{
+		for (u8 num : nums)
+		{
+			// Only the low bit of the alignment is part of the key for these formats.
+			for (u8 aligned : {4, 1})
+			{
+				nVifBlock block;
+				dVifMakeKey(block, upkType, num, 0, 0, aligned, 1, 1);
+				if (!v.vifBlocks.find(block))
+					dVifCompile<idx>(block, false);
+			}
+		}
+	}
+
+	DevCon.WriteLn("nVif%d: Precompiled %u unpack routines", idx, v.vifBlocks.size() - before);
+}
+
+_vifT __fi void dVifUnpack(const u8* data, bool isFill)
+{
+
+	nVifStruct&   v       = nVif[idx];
+	vifStruct&    vif     = MTVU_VifX;
+	VIFregisters& vifRegs = MTVU_VifXRegs;
+
+	const u8  upkType = (vif.cmd & 0x1f) | (vif.usn << 5);
+	const int doMask  = isFill ? 1 : (vif.cmd & 0x10);
+
+	nVifBlock block;
+	dVifMakeKey(block, upkType, vifRegs.num, doMask ? vifRegs.mask : 0, vifRegs.mode,
+		vif.start_aligned, vifRegs.cycle.cl, vifRegs.cycle.wl);
 
 	//DevCon.WriteLn("nVif%d: Recompiled Block!", idx);
 	//DevCon.WriteLn(L"[num=% 3d][upkType=0x%02x][scl=%d][cl=%d][wl=%d][mode=%d][m=%d][mask=%s]",
@@ -15,7 +15,7 @@
 
 #pragma once
 
-#include <array>
+#include <atomic>
 #include "fmt/core.h"
 #include "common/AlignedMalloc.h"
 
@@ -48,101 +48,152 @@ union nVifBlock
 
 }; // 16 bytes
 
-// 0x4000 is enough but 0x10000 allow
-// * to skip the compare value of the first double world in lookup
-// * to use a 16 bits move instead of an 'and' mask to compute the hashed key
-#define hSize 0x10000 // [usn*1:mask*1:upk*4:num*8] hash...
+// Lookup counters, readable from other threads.  Only the thread running the unpacks for a
+// given VIF writes them, so plain load/store pairs are enough (no locked increments).
+// They are only collected while the VIF statistics are shown on the OSD.
+struct nVifCacheStats
+{
+	std::atomic<u64> hits{0};
+	std::atomic<u64> misses{0};
+	std::atomic<u64> probes{0};
+	std::atomic<u64> compiles{0};
+
+	static __fi void bump(std::atomic<u64>& counter, u64 amount = 1)
+	{
+		if (!EmuConfig.GS.OsdShowVIFStats)
+			return;
 
-// HashBucket is a container which uses a built-in hash function
-// to perform quick searches. It is designed around the nVifBlock structure
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+};
+
+// HashBucket is an open-addressed (linear probing) cache of compiled unpack routines.
 //
-// The hash function is determined by taking the first bytes of data and
-// performing a modulus the size of hSize. So the most diverse-data should
-// be in the first bytes of the struct. (hence why nVifBlock is specifically sorted)
+// The whole key (num, upkType, mask, mode, aligned, cl and wl) goes through the hash, so
+// games which only vary the mask or cycle settings no longer pile up in a single chain.
+// Entries are padded to 32 bytes and the table is 64 byte aligned, so an entry never
+// straddles a cache line and a probe sequence walks whole lines.  The table doubles once it
+// is half full, which keeps the average probe length close to one.
 class HashBucket
 {
 protected:
-	std::array<nVifBlock*, hSize> m_bucket;
+	struct alignas(32) Entry
+	{
+		nVifBlock block;
+	};
+	static_assert(sizeof(Entry) == 32, "Two entries should fill a cache line");
 
-public:
-	HashBucket()
+	static constexpr u32 InitialSize = 0x1000;
+
+	Entry* m_table = nullptr;
+	u32 m_mask = 0;
+	u32 m_count = 0;
+
+	nVifCacheStats m_stats;
+
+	static __fi u32 hash(const nVifBlock& key)
 	{
-		m_bucket.fill(nullptr);
+		u64 h = (static_cast<u64>(key.key1) << 32) | key.key0;
+		h ^= static_cast<u64>(key.hash_key) * 0x9E3779B97F4A7C15ULL;
+		h *= 0xFF51AFD7ED558CCDULL;
+		return static_cast<u32>(h ^ (h >> 32));
 	}
 
-	~HashBucket() { clear(); }
+	static __fi bool matches(const nVifBlock& a, const nVifBlock& b)
+	{
+		return a.hash_key == b.hash_key && a.key0 == b.key0 && a.key1 == b.key1;
+	}
 
-	__fi nVifBlock* find(const nVifBlock& dataPtr)
+	void allocate(u32 size)
 	{
-		nVifBlock* chainpos = m_bucket[dataPtr.hash_key];
+		m_table = static_cast<Entry*>(_aligned_malloc(sizeof(Entry) * size, 64));
+		if (!m_table)
+			pxFailRel("Failed to allocate nVif block cache");
 
-		while (true)
-		{
-			if (chainpos->key0 == dataPtr.key0 && chainpos->key1 == dataPtr.key1)
-				return chainpos;
+		std::memset(m_table, 0, sizeof(Entry) * size);
+		m_mask = size - 1;
+		m_count = 0;
+	}
 
-			if (chainpos->startPtr == 0)
-				return nullptr;
+	void insert(const nVifBlock& block)
+	{
+		u32 pos = hash(block) & m_mask;
+		while (m_table[pos].block.startPtr != 0)
+			pos = (pos + 1) & m_mask;
 
-			chainpos++;
-		}
+		m_table[pos].block = block;
+		m_count++;
 	}
 
-	void add(const nVifBlock& dataPtr)
+	void grow()
 	{
-		u32 b = dataPtr.hash_key;
-
-		u32 size = bucket_size(dataPtr);
+		Entry* const old_table = m_table;
+		const u32 old_size = m_mask + 1;
 
-		// Warning there is an extra +1 due to the empty cell
-		// Performance note: 64B align to reduce cache miss penalty in `find`
-		if ((m_bucket[b] = (nVifBlock*)pcsx2_aligned_realloc(m_bucket[b], sizeof(nVifBlock) * (size + 2), 64, sizeof(nVifBlock) * (size + 1))) == NULL)
+		allocate(old_size * 2);
+		for (u32 i = 0; i < old_size; i++)
 		{
-			pxFailRel("Failed to allocate HashBucket Chain");
+			if (old_table[i].block.startPtr != 0)
+				insert(old_table[i].block);
 		}
 
-		// Replace the empty cell by the new block and create a new empty cell
-		memcpy(&m_bucket[b][size++], &dataPtr, sizeof(nVifBlock));
-		memset(&m_bucket[b][size], 0, sizeof(nVifBlock));
-
-		if (size > 3)
-			DevCon.Warning("recVifUnpk: Bucket 0x%04x has %d micro-programs", b, size);
+		_aligned_free(old_table);
 	}
 
-	u32 bucket_size(const nVifBlock& dataPtr)
-	{
-		nVifBlock* chainpos = m_bucket[dataPtr.hash_key];
+public:
+	HashBucket() = default;
+	~HashBucket() { clear(); }
 
-		u32 size = 0;
+	__fi nVifBlock* find(const nVifBlock& dataPtr)
+	{
+		u32 pos = hash(dataPtr) & m_mask;
+		u64 probes = 1;
 
-		while (chainpos->startPtr != 0)
+		while (true)
 		{
-			size++;
-			chainpos++;
+			nVifBlock& entry = m_table[pos].block;
+
+			if (entry.startPtr == 0)
+			{
+				nVifCacheStats::bump(m_stats.misses);
+				nVifCacheStats::bump(m_stats.probes, probes);
+				return nullptr;
+			}
+
+			if (matches(entry, dataPtr))
+			{
+				nVifCacheStats::bump(m_stats.hits);
+				nVifCacheStats::bump(m_stats.probes, probes);
+				return &entry;
+			}
+
+			pos = (pos + 1) & m_mask;
+			probes++;
 		}
+	}
+
+	void add(const nVifBlock& dataPtr)
+	{
+		if ((m_count + 1) * 2 > (m_mask + 1))
+			grow();
 
-		return size;
+		insert(dataPtr);
+		nVifCacheStats::bump(m_stats.compiles);
 	}
 
+	u32 size() const { return m_count; }
+	const nVifCacheStats& stats() const { return m_stats; }
+
 	void clear()
 	{
-		for (auto& bucket : m_bucket)
-			safe_aligned_free(bucket);
+		safe_aligned_free(m_table);
+		m_mask = 0;
+		m_count = 0;
 	}
 
 	void reset()
 	{
 		clear();
-
-		// Allocate an empty cell for all buckets
-		for (auto& bucket : m_bucket)
-		{
-			if ((bucket = (nVifBlock*)_aligned_malloc(sizeof(nVifBlock), 16)) == nullptr)
-			{
-				pxFailRel("Failed to allocate HashBucket Chain on reset");
-			}
-
-			memset(bucket, 0, sizeof(nVifBlock));
-		}
+		allocate(InitialSize);
 	}
 };
@@ -0,0 +1,163 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Checks that compiled expressions (used for breakpoint conditions) give the same results
+// as walking the postfix expression, including for the ones which fail to evaluate.
+
+#include "PrecompiledHeader.h"
+#include "pcsx2/DebugTools/ExpressionParser.h"
+#include "common/StringUtil.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	class TestExpressionFunctions : public IExpressionFunctions
+	{
+	public:
+		u64 regs[4] = {0x10, 0x20, 0x1000, 3};
+		u8 memory[16] = {0x78, 0x56, 0x34, 0x12, 0xEF, 0xCD, 0xAB, 0x89, 1, 2, 3, 4, 5, 6, 7, 8};
+
+		bool parseReference(char* str, u64& referenceIndex) override
+		{
+			static const char* names[] = {"a", "b", "c", "f"};
+			for (u64 i = 0; i < std::size(names); i++)
+			{
+				if (StringUtil::Strcasecmp(str, names[i]) == 0)
+				{
+					referenceIndex = i;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool parseSymbol(char* str, u64& symbolValue) override
+		{
+			return false;
+		}
+
+		u64 getReferenceValue(u64 referenceIndex) override
+		{
+			return regs[referenceIndex];
+		}
+
+		ExpressionType getReferenceType(u64 referenceIndex) override
+		{
+			return (referenceIndex == 3) ? EXPR_TYPE_FLOAT : EXPR_TYPE_UINT;
+		}
+
+		bool getMemoryValue(u32 address, int size, u64& dest, char* error) override
+		{
+			if (address < 0x1000 || address + size > 0x1000 + sizeof(memory) || (size != 1 && size != 2 && size != 4 && size != 8))
+			{
+				std::strcpy(error, "Invalid memory access");
+				return false;
+			}
+
+			dest = 0;
+			std::memcpy(&dest, &memory[address - 0x1000], size);
+			return true;
+		}
+	};
+} // namespace
+
+static void CheckExpression(TestExpressionFunctions& funcs, const char* infix)
+{
+	PostfixExpression postfix;
+	ASSERT_TRUE(initPostfixExpression(infix, &funcs, postfix)) << infix;
+
+	u64 expected = 0;
+	const bool expected_valid = parsePostfixExpression(postfix, &funcs, expected);
+
+	CompiledExpression compiled;
+	u64 result = 0;
+	const bool valid = compilePostfixExpression(postfix, &funcs, compiled) && evaluateCompiledExpression(compiled, &funcs, result);
+	EXPECT_EQ(valid, expected_valid) << infix;
+	if (valid && expected_valid)
+		EXPECT_EQ(result, expected) << infix;
+}
+
+static const char* s_expressions[] = {
+	"1", "a", "a + b * 2", "(a + b) * 2", "b / a", "b % 3", "a / (b - 0x20)", "a << 4 >> 2",
+	"a == 0x10 && b != 0", "a > b || b >= 0x20", "~a & 0xFF", "!a", "a ^ b | c", "-a",
+	"a ? b : c", "a == 1 ? 5 : b > 1 ? 6 : 7", "[c]", "[c + 4]", "[c, 1]", "[c + 2, 2]",
+	"[c, 8] == 0x89ABCDEF12345678", "[c + 0x100]", "[c, 3]", "f * 2", "a + f", "f < 4",
+	"1.5 + 2", "-f",
+};
+
+TEST(Expression, CompiledMatchesPostfix)
+{
+	TestExpressionFunctions funcs;
+	for (const char* expression : s_expressions)
+		CheckExpression(funcs, expression);
+}
+
+TEST(Expression, CompiledReadsCurrentValues)
+{
+	// Breakpoint conditions are compiled once, then evaluated as registers and memory change.
+	TestExpressionFunctions funcs;
+	std::vector<CompiledExpression> compiled(std::size(s_expressions));
+	for (size_t i = 0; i < std::size(s_expressions); i++)
+	{
+		PostfixExpression postfix;
+		ASSERT_TRUE(initPostfixExpression(s_expressions[i], &funcs, postfix)) << s_expressions[i];
+		ASSERT_TRUE(compilePostfixExpression(postfix, &funcs, compiled[i])) << s_expressions[i];
+
+		u64 result = 0;
+		evaluateCompiledExpression(compiled[i], &funcs, result);
+	}
+
+	funcs.regs[0] = 0x30;
+	funcs.regs[1] = 0;
+	funcs.regs[2] = 0x1004;
+	funcs.memory[4] = 0x55;
+	funcs.memory[6] = 0xAA;
+
+	for (size_t i = 0; i < std::size(s_expressions); i++)
+	{
+		PostfixExpression postfix;
+		ASSERT_TRUE(initPostfixExpression(s_expressions[i], &funcs, postfix)) << s_expressions[i];
+
+		u64 expected = 0;
+		const bool expected_valid = parsePostfixExpression(postfix, &funcs, expected);
+
+		u64 result = 0;
+		const bool valid = evaluateCompiledExpression(compiled[i], &funcs, result);
+		EXPECT_EQ(valid, expected_valid) << s_expressions[i];
+		if (valid && expected_valid)
+			EXPECT_EQ(result, expected) << s_expressions[i];
+	}
+
+	// The same object also follows a change back.
+	u64 result = 0;
+	funcs.regs[0] = 0x10;
+	ASSERT_TRUE(evaluateCompiledExpression(compiled[1], &funcs, result));
+	EXPECT_EQ(result, 0x10u);
+}
+
+TEST(Expression, CompiledUnaryPlus)
+{
+	TestExpressionFunctions funcs;
+	PostfixExpression postfix;
+	ASSERT_TRUE(initPostfixExpression("+a", &funcs, postfix));
+
+	CompiledExpression compiled;
+	u64 result = 0;
+	ASSERT_TRUE(compilePostfixExpression(postfix, &funcs, compiled));
+	ASSERT_TRUE(evaluateCompiledExpression(compiled, &funcs, result));
+	EXPECT_EQ(result, 0x10u);
+}
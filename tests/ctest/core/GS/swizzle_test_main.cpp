@@ -17,49 +17,10 @@
 #include "pcsx2/GS/GSBlock.h"
 #include "pcsx2/GS/GSClut.h"
 #include "pcsx2/GS/MultiISA.h"
+#include "../MultiISATest.h"
 #include <gtest/gtest.h>
 #include <string.h>
 
-#ifdef MULTI_ISA_UNSHARED_COMPILATION
-
-enum class TestISA
-{
-	isa_sse4,
-	isa_avx,
-	isa_avx2,
-	isa_native,
-};
-
-static bool CheckCapabilities(TestISA required_caps)
-{
-	x86caps.Identify();
-	if (required_caps == TestISA::isa_avx && !x86caps.hasAVX)
-		return false;
-	if (required_caps == TestISA::isa_avx2 && !x86caps.hasAVX2)
-		return false;
-
-	return true;
-}
-
-#define MULTI_ISA_STRINGIZE_(x) #x
-#define MULTI_ISA_STRINGIZE(x) MULTI_ISA_STRINGIZE_(x)
-
-#define MULTI_ISA_CONCAT_(a, b) a##b
-#define MULTI_ISA_CONCAT(a, b) MULTI_ISA_CONCAT_(a, b)
-
-#define MULTI_ISA_TEST(group, name) TEST(MULTI_ISA_CONCAT(MULTI_ISA_CONCAT(MULTI_ISA_UNSHARED_COMPILATION, _), group), name)
-#define SKIP_IF_UNSUPPORTED() \
-	if (!CheckCapabilities(TestISA::MULTI_ISA_UNSHARED_COMPILATION)) { \
-		GTEST_SKIP() << "Host CPU does not support " MULTI_ISA_STRINGIZE(MULTI_ISA_UNSHARED_COMPILATION); \
-	}
-
-#else
-
-#define MULTI_ISA_TEST(group, name) TEST(group, name)
-#define SKIP_IF_UNSUPPORTED()
-
-#endif
-
 MULTI_ISA_UNSHARED_START
 
 static void swizzle(const u8* table, u8* dst, const u8* src, int bpp, bool deswizzle)
@@ -0,0 +1,99 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Checks that the file names textures are dumped to are recognised as the same textures when
+// the dump directory is indexed, so nothing already on disk gets dumped again.
+
+#include "PrecompiledHeader.h"
+#include "pcsx2/GS/GSLocalMemory.h"
+#include "pcsx2/GS/Renderers/HW/GSTextureReplacements.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace
+{
+	class TextureReplacementsTest : public ::testing::Test
+	{
+	protected:
+		static void SetUpTestSuite()
+		{
+			// fills in the PSM table, which decides whether a name has a palette
+			s_mem = std::make_unique<GSLocalMemory>();
+		}
+
+		static void TearDownTestSuite()
+		{
+			s_mem.reset();
+		}
+
+		static GSTextureCache::HashCacheKey MakeKey(u32 psm)
+		{
+			GSTextureCache::HashCacheKey key;
+			key.TEX0Hash = 0x0123456789abcdefULL;
+			key.CLUTHash = 0xfedcba9876543210ULL;
+			key.TEX0.PSM = psm;
+			key.TEX0.TW = 8;
+			key.TEX0.TH = 7;
+			key.TEX0.TCC = 1;
+			key.TEXA.TA0 = 0x80;
+			key.TEXA.AEM = 1;
+			key.TEXA.TA1 = 0x7f;
+			return key;
+		}
+
+		static void ExpectRoundTrip(const GSTextureCache::HashCacheKey& key, u32 level)
+		{
+			const std::string filename(GSTextureReplacements::GetDumpFileName(key, level));
+			EXPECT_TRUE(GSTextureReplacements::IsDumpFileNameFor(filename, key, level)) << filename;
+
+			// a different mip level of the same texture is a different file
+			EXPECT_FALSE(GSTextureReplacements::IsDumpFileNameFor(filename, key, level + 1)) << filename;
+		}
+
+	private:
+		static inline std::unique_ptr<GSLocalMemory> s_mem;
+	};
+} // namespace
+
+TEST_F(TextureReplacementsTest, NonPalettedRoundTrip)
+{
+	const GSTextureCache::HashCacheKey key(MakeKey(PSM_PSMCT32));
+	ExpectRoundTrip(key, 0);
+	ExpectRoundTrip(key, 1);
+	ExpectRoundTrip(key, 5);
+}
+
+TEST_F(TextureReplacementsTest, PalettedRoundTrip)
+{
+	for (const u32 psm : {PSM_PSMT8, PSM_PSMT4HL})
+	{
+		const GSTextureCache::HashCacheKey key(MakeKey(psm));
+		ExpectRoundTrip(key, 0);
+		ExpectRoundTrip(key, 2);
+
+		// the CLUT hash is part of the name
+		GSTextureCache::HashCacheKey other_clut(key);
+		other_clut.CLUTHash ^= 1;
+		EXPECT_FALSE(GSTextureReplacements::IsDumpFileNameFor(GSTextureReplacements::GetDumpFileName(key, 0), other_clut, 0));
+	}
+}
+
+TEST_F(TextureReplacementsTest, OtherFilesAreIgnored)
+{
+	const GSTextureCache::HashCacheKey key(MakeKey(PSM_PSMCT32));
+	EXPECT_FALSE(GSTextureReplacements::IsDumpFileNameFor("", key, 0));
+	EXPECT_FALSE(GSTextureReplacements::IsDumpFileNameFor("readme.txt", key, 0));
+	EXPECT_FALSE(GSTextureReplacements::IsDumpFileNameFor("0123456789abcdef", key, 0));
+}
@@ -0,0 +1,313 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Runs the IPU decoder outside of a VM, either on synthetic CSC streams or on traces captured
+// with the IpuDumpTraces option.  Point PCSX2_IPU_TRACES at a directory of *.trace files to
+// replay them; each one is checked bit-for-bit against the output recorded at capture time.
+
+#include "PrecompiledHeader.h"
+#include "pcsx2/IPU/IPU.h"
+#include "pcsx2/IPU/IPU_MultiISA.h"
+#include "pcsx2/IPU/yuv2rgb.h"
+#include "pcsx2/GS/MultiISA.h"
+#include "../MultiISATest.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Timer.h"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <string.h>
+
+MULTI_ISA_UNSHARED_START
+
+static void ResetIPU()
+{
+	ipuReset();
+	g_ipu_thresh[0] = 0;
+	g_ipu_thresh[1] = 0;
+	std::memset(g_ipu_vqclut, 0, sizeof(g_ipu_vqclut));
+
+	// IDEC/BDEC only start a macroblock once IPU0 is ready to take it.
+	ipu0ch.chcr.STR = true;
+	ipu0ch.qwc = 0xffff;
+	ipu1ch.chcr.STR = false;
+}
+
+static u32 OutputQWCPerMacroblock(u32 cmd)
+{
+	const bool flag = (cmd >> 27) & 1; // OFM for IDEC/CSC/PACK, MBI for BDEC
+	switch (cmd >> 28)
+	{
+		case SCE_IPU_IDEC:
+		case SCE_IPU_CSC:
+			return flag ? sizeof(macroblock_rgb16) / 16 : sizeof(macroblock_rgb32) / 16;
+		case SCE_IPU_BDEC:
+			return flag ? sizeof(macroblock_8) / 16 : sizeof(macroblock_16) / 16;
+		case SCE_IPU_PACK:
+			return flag ? sizeof(macroblock_rgb16) / 16 : sizeof(g_ipu_indx4) / 16;
+		default:
+			return 0;
+	}
+}
+
+// Keeps the input FIFO topped up and the output FIFO drained until the worker either finishes
+// the current command or runs out of input.
+static void Pump(std::deque<u128>& input, std::vector<u128>& output)
+{
+	for (;;)
+	{
+		bool progress = false;
+		while (!input.empty() && g_BP.IFC < 8)
+		{
+			ipu_fifo.in.write(reinterpret_cast<u32*>(&input.front()), 1);
+			input.pop_front();
+			progress = true;
+		}
+
+		if (ipuRegs.ctrl.BUSY)
+		{
+			const u32 ifc = g_BP.IFC;
+			IPUWorker();
+			progress |= (g_BP.IFC != ifc);
+		}
+
+		while (ipuRegs.ctrl.OFC > 0)
+		{
+			u128 qw;
+			ipu_fifo.out.read(&qw, 1);
+			output.push_back(qw);
+			progress = true;
+		}
+
+		if (!progress)
+			break;
+	}
+}
+
+static bool RunCommand(u32 cmd, std::deque<u128>& input, std::vector<u128>& output)
+{
+	if (ipuCMDSetup(cmd))
+		Pump(input, output);
+
+	return !ipuRegs.ctrl.BUSY;
+}
+
+static void ReportThroughput(const char* what, size_t macroblocks, double seconds)
+{
+	std::printf("[%s] %s: %zu macroblocks in %.3f ms, %.0f macroblocks/s\n",
+		MULTI_ISA_STRINGIZE(CURRENT_ISA), what, macroblocks, seconds * 1000.0,
+		(seconds > 0.0) ? (macroblocks / seconds) : 0.0);
+}
+
+static void RandomMacroblock(std::mt19937& rng, macroblock_8& mb8)
+{
+	u8* bytes = reinterpret_cast<u8*>(&mb8);
+	for (size_t i = 0; i < sizeof(mb8); i++)
+		bytes[i] = static_cast<u8>(rng());
+}
+
+MULTI_ISA_TEST(IPUKernelTest, YUV2RGB)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	std::mt19937 rng(0x1234);
+	for (int i = 0; i < 1000; i++)
+	{
+		RandomMacroblock(rng, decoder.mb8);
+		yuv2rgb_reference();
+		const macroblock_rgb32 expected = decoder.rgb32;
+		yuv2rgb_sse2();
+		ASSERT_EQ(std::memcmp(&expected, &decoder.rgb32, sizeof(expected)), 0) << "macroblock " << i;
+	}
+}
+
+MULTI_ISA_TEST(IPUKernelTest, Dither)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	std::mt19937 rng(0x5678);
+	alignas(16) macroblock_rgb32 rgb32;
+	alignas(16) macroblock_rgb16 expected, actual;
+	for (int i = 0; i < 1000; i++)
+	{
+		u8* bytes = reinterpret_cast<u8*>(&rgb32);
+		for (size_t j = 0; j < sizeof(rgb32); j++)
+			bytes[j] = static_cast<u8>(rng());
+		// Make sure the alpha test sees both outcomes.
+		for (int j = 0; j < 16 * 16; j += 3)
+			rgb32.c[j / 16][j % 16].a = 0x40;
+
+		const int dte = i & 1;
+		ipu_dither_reference(rgb32, expected, dte);
+		ipu_dither_sse2(rgb32, actual, dte);
+		ASSERT_EQ(std::memcmp(&expected, &actual, sizeof(expected)), 0) << "macroblock " << i << " dte " << dte;
+	}
+}
+
+MULTI_ISA_TEST(IPUDecodeTest, CSC)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	static constexpr u32 count = 1024;
+	std::mt19937 rng(0x9abc);
+
+	for (u32 ofm = 0; ofm < 2; ofm++)
+	{
+		ResetIPU();
+
+		std::deque<u128> input;
+		std::vector<u128> expected;
+		for (u32 i = 0; i < count; i++)
+		{
+			alignas(16) macroblock_8 mb8;
+			RandomMacroblock(rng, mb8);
+			const u128* qw = reinterpret_cast<const u128*>(&mb8);
+			input.insert(input.end(), qw, qw + sizeof(mb8) / 16);
+
+			decoder.mb8 = mb8;
+			yuv2rgb_reference();
+			if (ofm)
+			{
+				alignas(16) macroblock_rgb16 rgb16;
+				ipu_dither_reference(decoder.rgb32, rgb16, 1);
+				expected.insert(expected.end(), reinterpret_cast<const u128*>(&rgb16), reinterpret_cast<const u128*>(&rgb16 + 1));
+			}
+			else
+			{
+				expected.insert(expected.end(), reinterpret_cast<const u128*>(&decoder.rgb32), reinterpret_cast<const u128*>(&decoder.rgb32 + 1));
+			}
+		}
+
+		// CSC's MBC field is 11 bits, so split the stream into several commands.
+		const u32 cmd = (SCE_IPU_CSC << 28) | (ofm << 27) | (ofm << 26);
+		std::vector<u128> output;
+		output.reserve(expected.size());
+
+		Common::Timer timer;
+		for (u32 done = 0; done < count; done += 512)
+			ASSERT_TRUE(RunCommand(cmd | 512, input, output));
+		ReportThroughput(ofm ? "CSC RGB16" : "CSC RGB32", count, timer.GetTimeSeconds());
+
+		ASSERT_EQ(output.size(), expected.size());
+		for (size_t i = 0; i < output.size(); i++)
+			ASSERT_EQ(std::memcmp(&output[i], &expected[i], sizeof(u128)), 0) << "qword " << i;
+	}
+}
+
+MULTI_ISA_TEST(IPUDecodeTest, TraceReplay)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	const char* dir = std::getenv("PCSX2_IPU_TRACES");
+	if (!dir || !*dir)
+		GTEST_SKIP() << "Set PCSX2_IPU_TRACES to a directory of IPU traces to replay them";
+
+	FileSystem::FindResultsArray files;
+	FileSystem::FindFiles(dir, "*.trace", FILESYSTEM_FIND_FILES, &files);
+	if (files.empty())
+		GTEST_SKIP() << "No IPU traces found in " << dir;
+
+	for (const FILESYSTEM_FIND_DATA& fd : files)
+	{
+		SCOPED_TRACE(fd.FileName);
+
+		const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(fd.FileName.c_str());
+		ASSERT_TRUE(data.has_value() && data->size() >= sizeof(IPUTraceHeader));
+
+		IPUTraceHeader header;
+		std::memcpy(&header, data->data(), sizeof(header));
+		ASSERT_EQ(header.magic, IPU_TRACE_MAGIC);
+		ASSERT_EQ(header.version, IPU_TRACE_VERSION);
+
+		// Split the trace into the register writes to replay and the output it produced.
+		std::vector<std::pair<IPUTraceRecord, u128>> events;
+		std::vector<u128> expected;
+		for (size_t pos = sizeof(header); pos < data->size();)
+		{
+			ASSERT_LE(pos + sizeof(IPUTraceRecord), data->size());
+			std::pair<IPUTraceRecord, u128> ev = {};
+			std::memcpy(&ev.first, data->data() + pos, sizeof(IPUTraceRecord));
+			pos += sizeof(IPUTraceRecord);
+
+			if (ev.first.type == IPUTraceEvent::Input || ev.first.type == IPUTraceEvent::Output)
+			{
+				ASSERT_LE(pos + sizeof(u128), data->size());
+				std::memcpy(&ev.second, data->data() + pos, sizeof(u128));
+				pos += sizeof(u128);
+			}
+
+			if (ev.first.type == IPUTraceEvent::Output)
+				expected.push_back(ev.second);
+			else
+				events.push_back(ev);
+		}
+
+		ResetIPU();
+		ipuRegs.ctrl._u32 = header.ctrl;
+		std::memcpy(g_ipu_thresh, header.thresh, sizeof(header.thresh));
+		std::memcpy(g_ipu_vqclut, header.vqclut, sizeof(header.vqclut));
+		std::memcpy(decoder.iq, header.iq, sizeof(header.iq));
+		std::memcpy(decoder.niq, header.niq, sizeof(header.niq));
+
+		std::deque<u128> input;
+		std::vector<u128> output;
+		output.reserve(expected.size());
+		size_t macroblocks = 0;
+		size_t cmd_start = 0;
+		u32 cmd = 0;
+
+		Common::Timer timer;
+		for (const auto& [record, qword] : events)
+		{
+			if (record.type == IPUTraceEvent::Input)
+			{
+				input.push_back(qword);
+				continue;
+			}
+
+			// Commands are recorded after their setup, so this also makes the quadwords the
+			// setup pulled from the FIFO (skipping FB bits) available before it runs.
+			Pump(input, output);
+
+			if (const u32 per_mb = OutputQWCPerMacroblock(cmd))
+				macroblocks += (output.size() - cmd_start) / per_mb;
+
+			if (record.type == IPUTraceEvent::Ctrl)
+			{
+				ipuWrite32(IPU_CTRL, record.value);
+				cmd = 0;
+			}
+			else
+			{
+				ipuCMDSetup(record.value);
+				cmd = record.value;
+				cmd_start = output.size();
+			}
+		}
+		Pump(input, output);
+		if (const u32 per_mb = OutputQWCPerMacroblock(cmd))
+			macroblocks += (output.size() - cmd_start) / per_mb;
+		ReportThroughput(std::string(Path::GetFileName(fd.FileName)).c_str(), macroblocks, timer.GetTimeSeconds());
+
+		const size_t compare = std::min(output.size(), expected.size());
+		for (size_t i = 0; i < compare; i++)
+			ASSERT_EQ(std::memcmp(&output[i], &expected[i], sizeof(u128)), 0) << "output qword " << i;
+		ASSERT_EQ(output.size(), expected.size());
+	}
+}
+
+MULTI_ISA_UNSHARED_END
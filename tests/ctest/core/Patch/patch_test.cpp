@@ -0,0 +1,132 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Checks that patching code on a write protected page through one of its aliases clears the
+// recompiled blocks by the address they were compiled from.
+
+#include "PrecompiledHeader.h"
+#include "pcsx2/Common.h"
+#include "pcsx2/Patch.h"
+#include "pcsx2/VMManager.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// Defined in Patch_Memory.cpp, Patch.cpp declares it the same way.
+extern u32 _ApplyCompiledPatches(const CompiledPatch* patches, size_t count);
+
+namespace
+{
+	static std::vector<std::pair<u32, u32>> s_cleared;
+
+	static void ClearStub(u32 addr, u32 size)
+	{
+		s_cleared.emplace_back(addr, size);
+	}
+
+	class PatchTest : public ::testing::Test
+	{
+	protected:
+		static void SetUpTestSuite()
+		{
+			// Only main RAM and its kseg0/uncached aliases are mapped, without fastmem, so no BIOS is needed.
+			s_old_fastmem = EmuConfig.Cpu.Recompiler.EnableFastmem;
+			EmuConfig.Cpu.Recompiler.EnableFastmem = false;
+			ASSERT_TRUE(VMManager::Internal::InitializeMemory());
+
+			vtlb_Init();
+			vtlb_MapBlock(eeMem->Main, 0x00000000, Ps2MemSize::MainRam);
+			vtlb_VMap(0x00000000, 0x00000000, Ps2MemSize::MainRam);
+			vtlb_VMap(0x20000000, 0x00000000, Ps2MemSize::MainRam);
+			vtlb_VMap(0x80000000, 0x00000000, Ps2MemSize::MainRam);
+		}
+
+		static void TearDownTestSuite()
+		{
+			VMManager::Internal::ReleaseMemory();
+			EmuConfig.Cpu.Recompiler.EnableFastmem = s_old_fastmem;
+		}
+
+		void SetUp() override
+		{
+			mmap_ResetBlockTracking();
+			std::memset(eeMem->Main, 0, Ps2MemSize::MainRam);
+
+			std::memset(&m_cpu, 0, sizeof(m_cpu));
+			m_cpu.Clear = ClearStub;
+			m_old_cpu = Cpu;
+			Cpu = &m_cpu;
+			s_cleared.clear();
+		}
+
+		void TearDown() override
+		{
+			mmap_ResetBlockTracking();
+			Cpu = m_old_cpu;
+		}
+
+		static u32 ReadMain32(u32 offset)
+		{
+			u32 value;
+			std::memcpy(&value, &eeMem->Main[offset], sizeof(value));
+			return value;
+		}
+
+	private:
+		static inline bool s_old_fastmem = true;
+		R5900cpu m_cpu;
+		R5900cpu* m_old_cpu = nullptr;
+	};
+} // namespace
+
+TEST_F(PatchTest, AliasedPatchClearsRecompiledAddress)
+{
+	// The recompiler protects pages by the address it compiled them from.
+	mmap_MarkCountedRamPage(0x00100000);
+	ASSERT_EQ(mmap_GetRamPageInfo(0x00100000), ProtMode_Write);
+
+	const CompiledPatch patches[] = {
+		{nullptr, CPU_EE, 4, 0x20100020, 0x55667788},
+		{nullptr, CPU_EE, 4, 0x80100010, 0x11223344},
+		{nullptr, CPU_EE, 2, 0x80100032, 0xAABB},
+	};
+	EXPECT_EQ(_ApplyCompiledPatches(patches, std::size(patches)), 3u);
+
+	EXPECT_EQ(ReadMain32(0x100020), 0x55667788u);
+	EXPECT_EQ(ReadMain32(0x100010), 0x11223344u);
+	EXPECT_EQ(ReadMain32(0x100030), 0xAABB0000u);
+
+	const std::vector<std::pair<u32, u32>> expected = {
+		{0x00100020, 1},
+		{0x00100010, 1},
+		{0x00100030, 1},
+	};
+	EXPECT_EQ(s_cleared, expected);
+
+	// The page is still write protected afterwards, and unchanged values aren't written again.
+	EXPECT_EQ(mmap_GetRamPageInfo(0x00100000), ProtMode_Write);
+	s_cleared.clear();
+	EXPECT_EQ(_ApplyCompiledPatches(patches, std::size(patches)), 0u);
+	EXPECT_TRUE(s_cleared.empty());
+}
+
+TEST_F(PatchTest, UnprotectedPageIsNotCleared)
+{
+	const CompiledPatch patch = {nullptr, CPU_EE, 4, 0x80200000, 0xDEADBEEF};
+	EXPECT_EQ(_ApplyCompiledPatches(&patch, 1), 1u);
+	EXPECT_EQ(ReadMain32(0x200000), 0xDEADBEEFu);
+	EXPECT_TRUE(s_cleared.empty());
+}
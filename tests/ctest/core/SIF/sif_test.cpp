@@ -0,0 +1,312 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Runs randomized SIF0 and SIF1 chain transfers with and without the bulk copy path, and checks
+// that memory, the FIFOs, the DMA registers, cycle counts and raised interrupts all match.
+
+#include "PrecompiledHeader.h"
+
+#define _PC_ // disables MIPS opcode macros.
+
+#include "pcsx2/R3000A.h"
+#include "pcsx2/Common.h"
+#include "pcsx2/Sif.h"
+#include "pcsx2/IopHw.h"
+#include "pcsx2/IopDma.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Only the start of EE RAM is used by the transfers.
+	static constexpr u32 EE_COMPARE_SIZE = _8mb;
+
+	struct SifState
+	{
+		std::vector<u8> ee_main;
+		std::vector<u8> iop_main;
+		_sif sif[2];
+		u32 ee_madr[2], ee_qwc[2], ee_tadr[2], ee_chcr[2];
+		u32 iop_madr[2], iop_bcr[2], iop_chcr[2];
+		u32 iop_tadr;
+		u32 dmac_stat, dmac_stadr;
+		u32 ee_interrupt, iop_interrupt, ee_dmastall;
+		u32 iop_icr2;
+		u32 clear_calls, clear_words;
+	};
+
+	static u32 s_clear_calls;
+	static u32 s_clear_words;
+
+	static void ClearStub(u32 addr, u32 size)
+	{
+		s_clear_calls++;
+		s_clear_words += size;
+	}
+
+	class SifTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_ee_mem = std::make_unique<EEVM_MemoryAllocMess>();
+			m_iop_mem = std::make_unique<IopVM_MemoryAllocMess>();
+			m_old_ee_mem = eeMem;
+			m_old_iop_mem = iopMem;
+			m_old_psx_cpu = psxCpu;
+			eeMem = m_ee_mem.get();
+			iopMem = m_iop_mem.get();
+
+			// The IOP recompiler would drop blocks for the written range, only count what's cleared.
+			std::memset(&m_cpu, 0, sizeof(m_cpu));
+			m_cpu.Clear = ClearStub;
+			psxCpu = &m_cpu;
+		}
+
+		void TearDown() override
+		{
+			eeMem = m_old_ee_mem;
+			iopMem = m_old_iop_mem;
+			psxCpu = m_old_psx_cpu;
+			sifBulkTransfers = true;
+		}
+
+		static void ResetState()
+		{
+			std::memset(eeMem->Main, 0, EE_COMPARE_SIZE);
+			std::memset(iopMem->Main, 0, sizeof(iopMem->Main));
+			std::memset(eeHw, 0, sizeof(eeHw));
+			std::memset(iopHw, 0, sizeof(iopHw));
+			std::memset(&cpuRegs, 0, sizeof(cpuRegs));
+			std::memset(&psxRegs, 0, sizeof(psxRegs));
+			sifReset();
+			s_clear_calls = 0;
+			s_clear_words = 0;
+		}
+
+		// SIF0: chain of IOP tags pointing at random data, sent to consecutive EE destinations.
+		static void RunSIF0(std::mt19937& rng)
+		{
+			for (u32 i = 0; i < 0x40000; i++)
+				reinterpret_cast<u32*>(iopMem->Main)[i] = rng();
+
+			const u32 tadr = 0x100000;
+			u32 ee_dst = 0x200000 + (rng() % 64) * 16;
+			u32 src = 0x1000;
+			const int ntags = 1 + rng() % 5;
+			for (int t = 0; t < ntags; t++)
+			{
+				u32 words = (rng() % 3 == 0) ? (rng() % 40) : (rng() % 6000);
+				if (rng() % 4 == 0)
+					words &= ~3u;
+
+				const u32 qwc = (words + 3) / 4;
+				const bool last = (t == ntags - 1);
+				u32* tag = reinterpret_cast<u32*>(&iopMem->Main[tadr + t * 16]);
+				tag[0] = src | (last ? 0x40000000 : 0);
+				tag[1] = words;
+				tag[2] = (qwc & 0xffff) | ((last ? TAG_END : TAG_CNT) << 28);
+				tag[3] = ee_dst;
+				ee_dst += qwc * 16 + (rng() % 4) * 16;
+				src += words * 4 + (rng() % 8) * 4;
+			}
+
+			hw_dma9.tadr = tadr;
+			sif0.iop.busy = true;
+			sif0.ee.busy = true;
+			sif0ch.chcr.STR = true;
+			sif0ch.chcr.MOD = CHAIN_MODE;
+			dmacRegs.ctrl.STS = (rng() & 1) ? STS_SIF0 : NO_STS;
+			sif0.fifo.readPos = sif0.fifo.writePos = rng() % FIFO_SIF_W;
+
+			for (int pass = 0; pass < 8 && (sif0.iop.busy || sif0.ee.busy); pass++)
+				SIF0Dma();
+		}
+
+		// SIF1: EE chain of tags, the data of which is a stream of IOP tags and their data.
+		static void RunSIF1(std::mt19937& rng)
+		{
+			std::vector<u32> stream;
+			u32 iop_dst = 0x10000;
+			const int iop_tags = 1 + rng() % 4;
+			for (int t = 0; t < iop_tags; t++)
+			{
+				const u32 words = ((rng() % 3 == 0) ? (rng() % 40) : (rng() % 7000)) & ~3u;
+				const bool last = (t == iop_tags - 1);
+				stream.push_back(iop_dst | (last ? 0x40000000 : 0));
+				stream.push_back(words);
+				stream.push_back(0);
+				stream.push_back(0);
+				for (u32 i = 0; i < words; i++)
+					stream.push_back(rng());
+				iop_dst += words * 4 + (rng() % 4) * 16;
+			}
+			while (stream.size() & 3)
+				stream.push_back(0);
+
+			const u32 tadr = 0x400000;
+			const u32 total_qwc = static_cast<u32>(stream.size() / 4);
+			const int ee_tags = 1 + rng() % 4;
+			u32 pos = 0;
+			u32 at = tadr;
+			for (int t = 0; t < ee_tags; t++)
+			{
+				const bool last = (t == ee_tags - 1);
+				const u32 qwc = std::min<u32>(last ? (total_qwc - pos) : std::min<u32>(total_qwc - pos, rng() % (total_qwc + 1)), 0xffff);
+				u32* tag = reinterpret_cast<u32*>(&eeMem->Main[at]);
+				tag[0] = qwc | ((last ? TAG_END : TAG_CNT) << 28);
+				tag[1] = 0;
+				std::memcpy(&eeMem->Main[at + 16], &stream[pos * 4], qwc * 16);
+				at += 16 + qwc * 16;
+				pos += qwc;
+			}
+
+			sif1ch.tadr = tadr;
+			sif1ch.qwc = 0;
+			sif1ch.chcr.STR = true;
+			sif1ch.chcr.MOD = CHAIN_MODE;
+			sif1.ee.busy = true;
+			sif1.iop.busy = true;
+			sif1.fifo.readPos = sif1.fifo.writePos = rng() % FIFO_SIF_W;
+
+			for (int pass = 0; pass < 8 && (sif1.iop.busy || sif1.ee.busy); pass++)
+				SIF1Dma();
+		}
+
+		static SifState Run(u32 seed, bool bulk)
+		{
+			ResetState();
+			sifBulkTransfers = bulk;
+
+			std::mt19937 rng(seed);
+			RunSIF0(rng);
+			RunSIF1(rng);
+
+			SifState state;
+			state.ee_main.assign(eeMem->Main, eeMem->Main + EE_COMPARE_SIZE);
+			state.iop_main.assign(iopMem->Main, iopMem->Main + sizeof(iopMem->Main));
+			state.sif[0] = sif0;
+			state.sif[1] = sif1;
+
+			DMACh* const ee_channels[2] = {&sif0ch, &sif1ch};
+			for (int i = 0; i < 2; i++)
+			{
+				state.ee_madr[i] = ee_channels[i]->madr;
+				state.ee_qwc[i] = ee_channels[i]->qwc;
+				state.ee_tadr[i] = ee_channels[i]->tadr;
+				state.ee_chcr[i] = ee_channels[i]->chcr._u32;
+			}
+
+			state.iop_madr[0] = hw_dma9.madr;
+			state.iop_bcr[0] = hw_dma9.bcr;
+			state.iop_chcr[0] = hw_dma9.chcr;
+			state.iop_tadr = hw_dma9.tadr;
+			state.iop_madr[1] = hw_dma10.madr;
+			state.iop_bcr[1] = hw_dma10.bcr;
+			state.iop_chcr[1] = hw_dma10.chcr;
+
+			state.dmac_stat = dmacRegs.stat._u32;
+			state.dmac_stadr = dmacRegs.stadr.ADDR;
+			state.ee_interrupt = cpuRegs.interrupt;
+			state.iop_interrupt = psxRegs.interrupt;
+			state.ee_dmastall = cpuRegs.dmastall;
+			state.iop_icr2 = HW_DMA_ICR2;
+			state.clear_calls = s_clear_calls;
+			state.clear_words = s_clear_words;
+			return state;
+		}
+
+		static void ExpectFifoEqual(const sifFifo& fifo, const sifFifo& bulk)
+		{
+			EXPECT_EQ(fifo.size, bulk.size);
+			EXPECT_EQ(fifo.readPos, bulk.readPos);
+			EXPECT_EQ(fifo.writePos, bulk.writePos);
+			EXPECT_EQ(std::memcmp(fifo.data, bulk.data, sizeof(fifo.data)), 0);
+			EXPECT_EQ(std::memcmp(fifo.junk, bulk.junk, sizeof(fifo.junk)), 0);
+		}
+
+		static void ExpectSifEqual(const _sif& fifo, const _sif& bulk)
+		{
+			ExpectFifoEqual(fifo.fifo, bulk.fifo);
+			EXPECT_EQ(fifo.ee.end, bulk.ee.end);
+			EXPECT_EQ(fifo.ee.busy, bulk.ee.busy);
+			EXPECT_EQ(fifo.ee.cycles, bulk.ee.cycles);
+			EXPECT_EQ(fifo.iop.end, bulk.iop.end);
+			EXPECT_EQ(fifo.iop.busy, bulk.iop.busy);
+			EXPECT_EQ(fifo.iop.cycles, bulk.iop.cycles);
+			EXPECT_EQ(fifo.iop.writeJunk, bulk.iop.writeJunk);
+			EXPECT_EQ(fifo.iop.counter, bulk.iop.counter);
+			EXPECT_EQ(fifo.iop.data.data, bulk.iop.data.data);
+			EXPECT_EQ(fifo.iop.data.words, bulk.iop.data.words);
+		}
+
+	private:
+		std::unique_ptr<EEVM_MemoryAllocMess> m_ee_mem;
+		std::unique_ptr<IopVM_MemoryAllocMess> m_iop_mem;
+		EEVM_MemoryAllocMess* m_old_ee_mem = nullptr;
+		IopVM_MemoryAllocMess* m_old_iop_mem = nullptr;
+		R3000Acpu* m_old_psx_cpu = nullptr;
+		R3000Acpu m_cpu;
+	};
+} // namespace
+
+TEST_F(SifTest, BulkTransfersMatchFifo)
+{
+	u32 fifo_clear_calls = 0;
+	u32 bulk_clear_calls = 0;
+
+	for (u32 seed = 0; seed < 64; seed++)
+	{
+		SCOPED_TRACE(testing::Message() << "seed " << seed);
+
+		const SifState fifo = Run(seed, false);
+		const SifState bulk = Run(seed, true);
+
+		EXPECT_TRUE(fifo.ee_main == bulk.ee_main);
+		EXPECT_TRUE(fifo.iop_main == bulk.iop_main);
+		ExpectSifEqual(fifo.sif[0], bulk.sif[0]);
+		ExpectSifEqual(fifo.sif[1], bulk.sif[1]);
+
+		for (int i = 0; i < 2; i++)
+		{
+			EXPECT_EQ(fifo.ee_madr[i], bulk.ee_madr[i]);
+			EXPECT_EQ(fifo.ee_qwc[i], bulk.ee_qwc[i]);
+			EXPECT_EQ(fifo.ee_tadr[i], bulk.ee_tadr[i]);
+			EXPECT_EQ(fifo.ee_chcr[i], bulk.ee_chcr[i]);
+			EXPECT_EQ(fifo.iop_madr[i], bulk.iop_madr[i]);
+			EXPECT_EQ(fifo.iop_bcr[i], bulk.iop_bcr[i]);
+			EXPECT_EQ(fifo.iop_chcr[i], bulk.iop_chcr[i]);
+		}
+		EXPECT_EQ(fifo.iop_tadr, bulk.iop_tadr);
+
+		EXPECT_EQ(fifo.dmac_stat, bulk.dmac_stat);
+		EXPECT_EQ(fifo.dmac_stadr, bulk.dmac_stadr);
+		EXPECT_EQ(fifo.ee_interrupt, bulk.ee_interrupt);
+		EXPECT_EQ(fifo.iop_interrupt, bulk.iop_interrupt);
+		EXPECT_EQ(fifo.ee_dmastall, bulk.ee_dmastall);
+		EXPECT_EQ(fifo.iop_icr2, bulk.iop_icr2);
+
+		// The bulk path clears the whole range at once, rather than per load.
+		EXPECT_EQ(fifo.clear_words, bulk.clear_words);
+		fifo_clear_calls += fifo.clear_calls;
+		bulk_clear_calls += bulk.clear_calls;
+	}
+
+	// Make sure the bulk path was actually taken.
+	EXPECT_LT(bulk_clear_calls, fifo_clear_calls);
+}